@@ -0,0 +1,118 @@
+module axi4_memory #(
+    parameter ADDR_WIDTH     = 32,
+    parameter DATA_WIDTH     = 64,
+    parameter ID_WIDTH       = 4,
+    parameter MEM_ADDR_WIDTH = 10   // depth = 1024 words
+)(
+    input  logic                    aclk,
+    input  logic                    aresetn,
+
+    // ---------------------------------
+    // AXI4 Slave
+    // ---------------------------------
+    input  logic [ID_WIDTH-1:0]     s_axi_awid,
+    input  logic [ADDR_WIDTH-1:0]   s_axi_awaddr,
+    input  logic [7:0]              s_axi_awlen,
+    input  logic [2:0]              s_axi_awsize,
+    input  logic [1:0]              s_axi_awburst,
+    input  logic                    s_axi_awvalid,
+    output logic                    s_axi_awready,
+    input  logic [DATA_WIDTH-1:0]   s_axi_wdata,
+    input  logic [DATA_WIDTH/8-1:0] s_axi_wstrb,
+    input  logic                    s_axi_wlast,
+    input  logic                    s_axi_wvalid,
+    output logic                    s_axi_wready,
+    output logic [ID_WIDTH-1:0]     s_axi_bid,
+    output logic [1:0]              s_axi_bresp,
+    output logic                    s_axi_bvalid,
+    input  logic                    s_axi_bready,
+    input  logic [ID_WIDTH-1:0]     s_axi_arid,
+    input  logic [ADDR_WIDTH-1:0]   s_axi_araddr,
+    input  logic [7:0]              s_axi_arlen,
+    input  logic [2:0]              s_axi_arsize,
+    input  logic [1:0]              s_axi_arburst,
+    input  logic                    s_axi_arvalid,
+    output logic                    s_axi_arready,
+    output logic [ID_WIDTH-1:0]     s_axi_rid,
+    output logic [DATA_WIDTH-1:0]   s_axi_rdata,
+    output logic [1:0]              s_axi_rresp,
+    output logic                    s_axi_rlast,
+    output logic                    s_axi_rvalid,
+    input  logic                    s_axi_rready
+);
+    // Word-addressed INCR bursts; one write and one read burst in flight.
+    localparam WORD_SHIFT = $clog2(DATA_WIDTH/8);
+
+    logic [DATA_WIDTH-1:0] mem [0:(1<<MEM_ADDR_WIDTH)-1];
+
+    // -------------------------------------------
+    // Write path
+    // -------------------------------------------
+    typedef enum logic [1:0] {
+        W_IDLE,
+        W_DATA,
+        W_RESP
+    } w_state_t;
+
+    w_state_t                w_state;
+    logic [MEM_ADDR_WIDTH-1:0] w_addr;
+
+    assign s_axi_awready = (w_state == W_IDLE);
+    assign s_axi_wready  = (w_state == W_DATA);
+    assign s_axi_bvalid  = (w_state == W_RESP);
+    assign s_axi_bresp   = 2'b00;
+
+    always_ff @(posedge aclk) begin
+        if (!aresetn) begin
+            w_state <= W_IDLE;
+        end else begin
+            case (w_state)
+                W_IDLE: if (s_axi_awvalid) begin
+                    s_axi_bid <= s_axi_awid;
+                    w_addr    <= s_axi_awaddr[WORD_SHIFT +: MEM_ADDR_WIDTH];
+                    w_state   <= W_DATA;
+                end
+                W_DATA: if (s_axi_wvalid) begin
+                    for (int b = 0; b < DATA_WIDTH/8; b++) begin
+                        if (s_axi_wstrb[b]) mem[w_addr][b*8 +: 8] <= s_axi_wdata[b*8 +: 8];
+                    end
+                    w_addr <= w_addr + 1'b1;
+                    if (s_axi_wlast) w_state <= W_RESP;
+                end
+                W_RESP: if (s_axi_bready) w_state <= W_IDLE;
+                default: w_state <= W_IDLE;
+            endcase
+        end
+    end
+
+    // -------------------------------------------
+    // Read path
+    // -------------------------------------------
+    logic                      r_busy;
+    logic [MEM_ADDR_WIDTH-1:0] r_addr;
+    logic [7:0]                r_left;
+
+    assign s_axi_arready = !r_busy;
+    assign s_axi_rvalid  = r_busy;
+    assign s_axi_rdata   = mem[r_addr];
+    assign s_axi_rresp   = 2'b00;
+    assign s_axi_rlast   = (r_left == 0);
+
+    always_ff @(posedge aclk) begin
+        if (!aresetn) begin
+            r_busy <= 1'b0;
+        end else if (!r_busy) begin
+            if (s_axi_arvalid) begin
+                r_busy    <= 1'b1;
+                s_axi_rid <= s_axi_arid;
+                r_addr    <= s_axi_araddr[WORD_SHIFT +: MEM_ADDR_WIDTH];
+                r_left    <= s_axi_arlen;
+            end
+        end else if (s_axi_rready) begin
+            r_addr <= r_addr + 1'b1;
+            if (r_left == 0) r_busy <= 1'b0;
+            else             r_left <= r_left - 1'b1;
+        end
+    end
+
+endmodule
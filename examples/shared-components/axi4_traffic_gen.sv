@@ -0,0 +1,108 @@
+module axi4_traffic_gen #(
+    parameter ADDR_WIDTH = 32,
+    parameter DATA_WIDTH = 64,
+    parameter ID_WIDTH   = 4,
+    parameter BASE_ADDR  = 0,
+    parameter BURST_LEN  = 16
+)(
+    input  logic                    aclk,
+    input  logic                    aresetn,
+
+    // ---------------------------------
+    // AXI4 Master
+    // ---------------------------------
+    output logic [ID_WIDTH-1:0]     m_axi_awid,
+    output logic [ADDR_WIDTH-1:0]   m_axi_awaddr,
+    output logic [7:0]              m_axi_awlen,
+    output logic [2:0]              m_axi_awsize,
+    output logic [1:0]              m_axi_awburst,
+    output logic                    m_axi_awvalid,
+    input  logic                    m_axi_awready,
+    output logic [DATA_WIDTH-1:0]   m_axi_wdata,
+    output logic [DATA_WIDTH/8-1:0] m_axi_wstrb,
+    output logic                    m_axi_wlast,
+    output logic                    m_axi_wvalid,
+    input  logic                    m_axi_wready,
+    input  logic [ID_WIDTH-1:0]     m_axi_bid,
+    input  logic [1:0]              m_axi_bresp,
+    input  logic                    m_axi_bvalid,
+    output logic                    m_axi_bready,
+    output logic [ID_WIDTH-1:0]     m_axi_arid,
+    output logic [ADDR_WIDTH-1:0]   m_axi_araddr,
+    output logic [7:0]              m_axi_arlen,
+    output logic [2:0]              m_axi_arsize,
+    output logic [1:0]              m_axi_arburst,
+    output logic                    m_axi_arvalid,
+    input  logic                    m_axi_arready,
+    input  logic [ID_WIDTH-1:0]     m_axi_rid,
+    input  logic [DATA_WIDTH-1:0]   m_axi_rdata,
+    input  logic [1:0]              m_axi_rresp,
+    input  logic                    m_axi_rlast,
+    input  logic                    m_axi_rvalid,
+    output logic                    m_axi_rready
+);
+    // Conceptually:
+    //   write one BURST_LEN-beat INCR burst, read it back, move on to the
+    //   next burst-sized block above BASE_ADDR
+    localparam BYTES = DATA_WIDTH / 8;
+
+    typedef enum logic [2:0] {
+        S_AW,
+        S_W,
+        S_B,
+        S_AR,
+        S_R
+    } state_t;
+
+    state_t          state;
+    logic [7:0]      beat;
+    logic [ADDR_WIDTH-1:0] addr;
+
+    assign m_axi_awid    = '0;
+    assign m_axi_awaddr  = addr;
+    assign m_axi_awlen   = 8'(BURST_LEN - 1);
+    assign m_axi_awsize  = 3'($clog2(BYTES));
+    assign m_axi_awburst = 2'b01;
+    assign m_axi_awvalid = (state == S_AW);
+
+    assign m_axi_wdata   = DATA_WIDTH'({addr, beat});
+    assign m_axi_wstrb   = '1;
+    assign m_axi_wlast   = (beat == 8'(BURST_LEN - 1));
+    assign m_axi_wvalid  = (state == S_W);
+    assign m_axi_bready  = (state == S_B);
+
+    assign m_axi_arid    = '0;
+    assign m_axi_araddr  = addr;
+    assign m_axi_arlen   = 8'(BURST_LEN - 1);
+    assign m_axi_arsize  = 3'($clog2(BYTES));
+    assign m_axi_arburst = 2'b01;
+    assign m_axi_arvalid = (state == S_AR);
+    assign m_axi_rready  = (state == S_R);
+
+    always_ff @(posedge aclk) begin
+        if (!aresetn) begin
+            state <= S_AW;
+            beat  <= '0;
+            addr  <= ADDR_WIDTH'(BASE_ADDR);
+        end else begin
+            case (state)
+                S_AW: if (m_axi_awready) state <= S_W;
+                S_W: if (m_axi_wready) begin
+                    beat <= beat + 1'b1;
+                    if (m_axi_wlast) begin
+                        beat  <= '0;
+                        state <= S_B;
+                    end
+                end
+                S_B: if (m_axi_bvalid) state <= S_AR;
+                S_AR: if (m_axi_arready) state <= S_R;
+                S_R: if (m_axi_rvalid && m_axi_rlast) begin
+                    addr  <= addr + ADDR_WIDTH'(BURST_LEN * BYTES);
+                    state <= S_AW;
+                end
+                default: state <= S_AW;
+            endcase
+        end
+    end
+
+endmodule
@@ -0,0 +1,210 @@
+#include "system_builder.hpp"
+#include "../base/parser.hpp"
+#include "../base/protocol.hpp"
+#include "../svgen/sv_emitter.hpp"
+
+#include <cctype>
+#include <stdexcept>
+
+const ComponentLibrary::Spec& ComponentLibrary::spec(const std::string& spec_path) {
+    auto sit = specs_.find(spec_path);
+    if (sit == specs_.end()) {
+        const json j = load_component_spec(spec_path);
+        Component proto;
+        parse_component_spec(j, proto);
+        sit = specs_.emplace(spec_path, Spec{std::move(proto.ports), parse_spec_parameters(j)}).first;
+    }
+    return sit->second;
+}
+
+const std::vector<std::string>& ComponentLibrary::parameters(const std::string& spec_path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return spec(spec_path).parameters;
+}
+
+void ComponentLibrary::instantiate(Component& comp) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const Spec& s = spec(comp.spec_path);
+    for (const auto& [param, value] : comp.parameters) {
+        check_spec_parameter(comp, param, s.parameters);
+    }
+    comp.ports.clear();
+    comp.ports.reserve(s.ports.size());
+    for (const auto& [name, port] : s.ports) {
+        comp.ports.emplace(name, port->clone());
+    }
+
+    auto mit = module_names_.find(comp.src_path);
+    if (mit == module_names_.end()) {
+        mit = module_names_.emplace(comp.src_path, find_module_name(comp.src_path)).first;
+    }
+    comp.module_name = mit->second;
+}
+
+SystemBuilder::SystemBuilder()
+    : library_(std::make_shared<ComponentLibrary>()) {}
+
+SystemBuilder::SystemBuilder(std::shared_ptr<ComponentLibrary> library)
+    : library_(library ? std::move(library) : std::make_shared<ComponentLibrary>()) {}
+
+SystemBuilder SystemBuilder::from_json(const json& j, std::shared_ptr<ComponentLibrary> library) {
+    SystemBuilder b(std::move(library));
+    parse_interface_ports(j, b.sys_);
+
+    if (j.contains("components")) {
+        for (const auto& c : j.at("components")) {
+            Component comp = parse_component_entry(c);
+            b.add_component(comp.name, comp.spec_path, comp.src_path, comp.parameters);
+        }
+    }
+
+    parse_connections(j, b.sys_);
+    parse_interconnects(j, b.sys_);
+    return b;
+}
+
+WirePort& SystemBuilder::add_wire_port(const std::string& name, PortMode mode, unsigned width) {
+    if (sys_.ports.count(name)) {
+        throw std::runtime_error("Duplicate top-level port name: " + name);
+    }
+    auto port = std::make_unique<WirePort>();
+    port->name = name;
+    port->mode = mode;
+    port->width = width;
+    WirePort& ref = *port;
+    sys_.ports.emplace(name, std::move(port));
+    return ref;
+}
+
+InterfacePort& SystemBuilder::add_interface_port(
+    const std::string& name,
+    const std::string& protocol,
+    PortMode mode,
+    const std::unordered_map<std::string, std::string>& parameters,
+    const std::unordered_map<std::string, std::string>& port_maps
+) {
+    if (sys_.ports.count(name)) {
+        throw std::runtime_error("Duplicate top-level port name: " + name);
+    }
+    auto port = std::make_unique<InterfacePort>();
+    port->name = name;
+    port->mode = mode;
+    port->protocol = lookup_protocol(protocol).name;
+    port->parameters = parameters;
+    port->port_maps = port_maps;
+    check_required_signals(*port, lookup_protocol(port->protocol));
+    InterfacePort& ref = *port;
+    sys_.ports.emplace(name, std::move(port));
+    return ref;
+}
+
+Component& SystemBuilder::add_component(
+    const std::string& name,
+    const std::string& spec_path,
+    const std::string& src_path,
+    const std::unordered_map<std::string, int>& parameters
+) {
+    if (sys_.components.count(name)) {
+        throw std::runtime_error("Duplicate component name: " + name);
+    }
+    Component comp;
+    comp.name = name;
+    comp.spec_path = spec_path;
+    comp.src_path = src_path;
+    comp.parameters = parameters;
+    library_->instantiate(comp);
+    return sys_.components.emplace(name, std::move(comp)).first->second;
+}
+
+void SystemBuilder::set_parameter(const std::string& instance, const std::string& param, int value) {
+    auto it = sys_.components.find(instance);
+    if (it == sys_.components.end()) {
+        throw std::runtime_error("Unknown component instance: " + instance);
+    }
+    check_spec_parameter(it->second, param, library_->parameters(it->second.spec_path));
+    it->second.parameters[param] = value;
+}
+
+void SystemBuilder::connect(const std::string& name, const std::string& src, const std::vector<std::string>& dsts) {
+    if (find_connection(sys_, name)) {
+        throw std::runtime_error("Duplicate connection name: " + name);
+    }
+    Connection c;
+    c.name = name;
+    c.src = EndpointRef::parse(src);
+    c.src.port_ptr = resolve_endpoint(sys_, c.src);
+    for (const auto& d : dsts) {
+        EndpointRef ep = EndpointRef::parse(d);
+        ep.port_ptr = resolve_endpoint(sys_, ep);
+        c.dsts.push_back(std::move(ep));
+    }
+    check_connection(c);
+    sys_.connections.push_back(std::move(c));
+}
+
+void SystemBuilder::add_interconnect(Interconnect ic) {
+    for (const auto& other : sys_.interconnects) {
+        if (other.name == ic.name) {
+            throw std::runtime_error("Duplicate interconnect name: " + ic.name);
+        }
+    }
+    resolve_interconnect(sys_, ic);
+    sys_.interconnects.push_back(std::move(ic));
+}
+
+static Connection& connection_named(SystemIR& sys, const std::string& name) {
+    Connection* c = find_connection(sys, name);
+    if (!c) {
+        throw std::runtime_error("Unknown connection: " + name);
+    }
+    return *c;
+}
+
+LinkConfig& SystemBuilder::link(const std::string& connection) {
+    Connection& c = connection_named(sys_, connection);
+    check_linkable(c);
+    return c.link;
+}
+
+void SystemBuilder::set_link_width(const std::string& connection, int width) {
+    Connection& c = connection_named(sys_, connection);
+
+    auto apply = [&](const EndpointRef& ep) {
+        if (ep.instance == "this" || ep.port_ptr->type != PortType::Interface) {
+            throw std::runtime_error("Link width requires component interface endpoints in connection: " + connection);
+        }
+        const auto* ip = static_cast<const InterfacePort*>(ep.port_ptr);
+        auto wit = ip->parameters.find("tdata_width");
+        if (wit == ip->parameters.end()) {
+            throw std::runtime_error("tdata_width parameter not found in interface port " + ep.instance + "." + ep.port);
+        }
+        const std::string& width_str = wit->second;
+        if (!width_str.empty() && std::isdigit(static_cast<unsigned char>(width_str.front()))) {
+            if (std::stoi(width_str) != width) {
+                throw std::runtime_error("Port " + ep.instance + "." + ep.port + " has a fixed tdata_width of " + width_str);
+            }
+            return;
+        }
+        set_parameter(ep.instance, width_str, width);
+    };
+
+    apply(c.src);
+    for (const auto& dst : c.dsts) {
+        apply(dst);
+    }
+}
+
+SystemBuilder SystemBuilder::clone() const {
+    SystemBuilder copy(library_);
+    copy.sys_ = clone_system(sys_);
+    return copy;
+}
+
+std::string SystemBuilder::emit(const std::string& module_name) const {
+    return emit_top_module_sv(sys_, module_name);
+}
+
+void SystemBuilder::emit(std::ostream& out, const std::string& module_name) const {
+    emit_top_module_sv(sys_, module_name, out);
+}
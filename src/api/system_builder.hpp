@@ -0,0 +1,94 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../base/system_ir.hpp"
+#include "../third_party/json.hpp"
+using json = nlohmann::json;
+
+// Parsed component specifications and SV module names, keyed by path, so that
+// instantiating the same component many times only touches the disk once.
+// A single library may be shared by builders running on different threads.
+class ComponentLibrary {
+public:
+    // Fill comp.ports and comp.module_name from comp.spec_path / comp.src_path,
+    // rejecting parameter overrides the spec does not declare.
+    void instantiate(Component& comp);
+
+    // Parameter names declared by the spec at spec_path.
+    const std::vector<std::string>& parameters(const std::string& spec_path);
+
+private:
+    struct Spec {
+        std::unordered_map<std::string, std::unique_ptr<Port>> ports;
+        std::vector<std::string> parameters;
+    };
+
+    // Parsed spec, loaded on first use; the caller holds mutex_.
+    const Spec& spec(const std::string& spec_path);
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, Spec> specs_;
+    std::unordered_map<std::string, std::string> module_names_;
+};
+
+// Programmatic construction of a SystemIR.  Ports, components and
+// connections are checked as they are added (protocols, required signals,
+// parameter names, endpoint compatibility), so such errors surface at the
+// call that caused them; signal widths are only resolved by emit().
+class SystemBuilder {
+public:
+    SystemBuilder();
+    explicit SystemBuilder(std::shared_ptr<ComponentLibrary> library);
+
+    // Build from the same JSON description accepted by the flow-forge executable.
+    static SystemBuilder from_json(const json& j, std::shared_ptr<ComponentLibrary> library = nullptr);
+
+    WirePort& add_wire_port(const std::string& name, PortMode mode, unsigned width = 1);
+    InterfacePort& add_interface_port(
+        const std::string& name,
+        const std::string& protocol,
+        PortMode mode,
+        const std::unordered_map<std::string, std::string>& parameters,
+        const std::unordered_map<std::string, std::string>& port_maps
+    );
+
+    Component& add_component(
+        const std::string& name,
+        const std::string& spec_path,
+        const std::string& src_path,
+        const std::unordered_map<std::string, int>& parameters = {}
+    );
+    // Override a parameter declared by the instance's component spec.
+    void set_parameter(const std::string& instance, const std::string& param, int value);
+
+    // Endpoints use the "instance.port" form, with "this" for top-level ports.
+    void connect(const std::string& name, const std::string& src, const std::vector<std::string>& dsts);
+
+    // Add a memory-mapped crossbar; endpoints use the same "instance.port" form.
+    void add_interconnect(Interconnect ic);
+
+    // Interconnect knobs of an existing connection.  Throws unless the
+    // connection can carry a link (see check_linkable).
+    LinkConfig& link(const std::string& connection);
+    // Set the tdata width on both sides of a connection by overriding the
+    // component parameter each endpoint's tdata_width refers to.
+    void set_link_width(const std::string& connection, int width);
+
+    // Independent copy sharing the same component library.
+    SystemBuilder clone() const;
+
+    const SystemIR& system() const { return sys_; }
+    const std::shared_ptr<ComponentLibrary>& library() const { return library_; }
+
+    std::string emit(const std::string& module_name = "top") const;
+    void emit(std::ostream& out, const std::string& module_name = "top") const;
+
+private:
+    SystemIR sys_;
+    std::shared_ptr<ComponentLibrary> library_;
+};
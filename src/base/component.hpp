@@ -1,13 +1,16 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include "port.hpp"
 
 // Represents an instantiated component in the system
 struct Component {
     std::string name;       // instance name
     std::string spec_path;  // path to component spec JSON
     std::string src_path;   // path to SystemVerilog source
+    std::string module_name; // SV module name; looked up from src_path when empty
 
     // Parameter overrides at instantiation
     // Keep values as strings to allow symbolic / numeric
@@ -15,6 +15,53 @@ EndpointRef EndpointRef::parse(const std::string& s) {
     return ep;
 }
 
+void check_connection(const Connection& conn) {
+    const Port* src = conn.src.port_ptr;
+    for (const auto& dst : conn.dsts) {
+        const Port* d = dst.port_ptr;
+        if (src == nullptr || d == nullptr) {
+            throw std::runtime_error("Unresolved endpoint in connection: " + conn.name);
+        }
+        if (src->type != d->type) {
+            throw std::runtime_error("Port type mismatch in connection " + conn.name + " to " + dst.instance + "." + dst.port);
+        }
+        if (src->type != PortType::Interface) {
+            continue;
+        }
+        const auto* src_ip = static_cast<const InterfacePort*>(src);
+        const auto* dst_ip = static_cast<const InterfacePort*>(d);
+        if (src_ip->protocol != dst_ip->protocol) {
+            throw std::runtime_error("Interface protocol mismatch in connection " + conn.name + " to " + dst.instance + "." + dst.port);
+        }
+        // the component side binds its signals to those of the other side
+        const bool into_top = (dst.instance == "this");
+        const InterfacePort* comp_ip = into_top ? src_ip : dst_ip;
+        const InterfacePort* other_ip = into_top ? dst_ip : src_ip;
+        for (const auto& [sig, sv_name] : comp_ip->port_maps) {
+            if (!other_ip->port_maps.count(sig)) {
+                throw std::runtime_error("Missing port map entry for " + sig + " in connection " + conn.name
+                                         + " to " + dst.instance + "." + dst.port);
+            }
+        }
+    }
+}
+
+void check_linkable(const Connection& conn) {
+    if (conn.dsts.size() != 1) {
+        throw std::runtime_error("Link buffering requires a single destination in connection: " + conn.name);
+    }
+    for (const EndpointRef* ep : {&conn.src, &conn.dsts.front()}) {
+        if (ep->instance == "this") {
+            throw std::runtime_error("Link buffering requires component endpoints in connection: " + conn.name);
+        }
+        const Port* p = ep->port_ptr;
+        if (p == nullptr || p->type != PortType::Interface
+            || static_cast<const InterfacePort*>(p)->protocol != "axi_stream") {
+            throw std::runtime_error("Link buffering requires axi_stream endpoints in connection: " + conn.name);
+        }
+    }
+}
+
 std::ostream& operator<<(std::ostream& os, const EndpointRef& ep) {
     os << ep.instance << "." << ep.port;
     return os;
@@ -26,6 +73,10 @@ std::ostream& operator<<(std::ostream& os, const Connection& conn) {
     for (const auto& dst : conn.dsts) {
         os << ", dst=" << dst;
     }
+    if (conn.link.buffered()) {
+        os << ", fifo_depth=" << conn.link.fifo_depth
+           << ", pipeline_stages=" << conn.link.pipeline_stages;
+    }
     os << ")";
 
     return os;
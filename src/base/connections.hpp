@@ -16,12 +16,31 @@ struct EndpointRef {
     static EndpointRef parse(const std::string& s);
 };
 
+// Interconnect knobs for a connection between two component ports.  When
+// buffered, the emitter places a flowforge_axis_link between the endpoints.
+struct LinkConfig {
+    unsigned fifo_depth = 0;       // 0: no FIFO
+    unsigned pipeline_stages = 0;  // register slices after the FIFO
+
+    bool buffered() const { return fifo_depth > 0 || pipeline_stages > 0; }
+};
+
 struct Connection {
     std::string name;
     EndpointRef src;
     std::vector<EndpointRef> dsts;
+    LinkConfig link;
 };
 
+// Throw unless every destination of the (resolved) connection is compatible
+// with its source: same port type and protocol, and every signal mapped by
+// the receiving component port also mapped on the other side.
+void check_connection(const Connection& conn);
+
+// Throw unless a link can be placed on the (resolved) connection: a single
+// destination, and axi_stream interface ports of components on both ends.
+void check_linkable(const Connection& conn);
+
 
 std::ostream& operator<<(std::ostream& os, const EndpointRef& ep);
 std::ostream& operator<<(std::ostream& os, const Connection& conn);
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "interconnect.hpp"
+#include "system_ir.hpp"
+
+#include <stdexcept>
+
+// Masters attach through a component master port or a top-level slave port
+// driven from outside; slaves the other way round.
+static void check_endpoint(const SystemIR& sys, const Interconnect& ic, EndpointRef& ep, bool is_master) {
+    ep.port_ptr = resolve_endpoint(sys, ep);
+
+    if (ep.port_ptr->type != PortType::Interface) {
+        throw std::runtime_error("Interconnect " + ic.name + ": " + ep.instance + "." + ep.port + " is not an interface port");
+    }
+    const auto* ip = static_cast<const InterfacePort*>(ep.port_ptr);
+    if (ip->protocol != ic.protocol) {
+        throw std::runtime_error("Interconnect " + ic.name + ": " + ep.instance + "." + ep.port
+                                 + " uses " + ip->protocol + ", expected " + ic.protocol);
+    }
+
+    const bool top = (ep.instance == "this");
+    const PortMode expected = (is_master != top) ? PortMode::Master : PortMode::Slave;
+    if (ip->mode != expected) {
+        throw std::runtime_error("Interconnect " + ic.name + ": " + ep.instance + "." + ep.port
+                                 + " must be a " + to_string(expected) + " port");
+    }
+}
+
+void resolve_interconnect(const SystemIR& sys, Interconnect& ic) {
+    if (ic.protocol != "axi4" && ic.protocol != "axi4_lite") {
+        throw std::runtime_error("Interconnect " + ic.name + ": unsupported protocol " + ic.protocol);
+    }
+    if (ic.masters.empty() || ic.slaves.empty()) {
+        throw std::runtime_error("Interconnect " + ic.name + " needs at least one master and one slave");
+    }
+    if (ic.max_outstanding == 0) {
+        throw std::runtime_error("Interconnect " + ic.name + ": max_outstanding must be at least 1");
+    }
+
+    for (auto& m : ic.masters) {
+        check_endpoint(sys, ic, m, true);
+    }
+
+    for (size_t i = 0; i < ic.slaves.size(); ++i) {
+        AddressWindow& w = ic.slaves[i];
+        check_endpoint(sys, ic, w.port, false);
+
+        if (w.size == 0 || (w.size & (w.size - 1)) != 0 || (w.base & (w.size - 1)) != 0) {
+            throw std::runtime_error("Interconnect " + ic.name + ": window of " + w.port.instance + "." + w.port.port
+                                     + " must have a power-of-two size and a size-aligned base");
+        }
+        for (size_t j = 0; j < i; ++j) {
+            const AddressWindow& o = ic.slaves[j];
+            if (w.base < o.base + o.size && o.base < w.base + w.size) {
+                throw std::runtime_error("Interconnect " + ic.name + ": windows of " + o.port.instance + "." + o.port.port
+                                         + " and " + w.port.instance + "." + w.port.port + " overlap");
+            }
+        }
+    }
+}
+
+std::ostream& operator<<(std::ostream& os, const Interconnect& ic) {
+    os << "Interconnect(name=" << ic.name
+       << ", protocol=" << ic.protocol
+       << ", max_outstanding=" << ic.max_outstanding;
+    for (const auto& m : ic.masters) {
+        os << ", master=" << m;
+    }
+    for (const auto& s : ic.slaves) {
+        os << ", slave=" << s.port << "@0x" << std::hex << s.base << "+0x" << s.size << std::dec;
+    }
+    os << ")";
+
+    return os;
+}
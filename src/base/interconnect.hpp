@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "connections.hpp"
+
+struct SystemIR;
+
+// A slave of a memory-mapped interconnect and the address window routed to it.
+struct AddressWindow {
+    EndpointRef port;
+    uint64_t base = 0;
+    uint64_t size = 0;   // power of two; base must be size-aligned
+};
+
+// Memory-mapped crossbar (axi4 or axi4_lite) between master and slave
+// interface ports.  Addresses outside every window get a DECERR response.
+struct Interconnect {
+    std::string name;
+    std::string protocol;
+    std::vector<EndpointRef> masters;
+    std::vector<AddressWindow> slaves;
+    unsigned max_outstanding = 4;   // per master and direction
+};
+
+// Resolve the endpoint pointers of ic against sys and check that the
+// endpoints and address map are usable.  Throws on the first problem.
+void resolve_interconnect(const SystemIR& sys, Interconnect& ic);
+
+std::ostream& operator<<(std::ostream& os, const Interconnect& ic);
@@ -1,6 +1,8 @@
 #include "connections.hpp"
 #include "component.hpp"
 #include "parser.hpp"
+#include "protocol.hpp"
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 
@@ -27,7 +29,7 @@ static void populate_port_map(const json& j,
             auto port = std::make_unique<InterfacePort>();
             port->name = name;
             port->mode = parse_mode(mode_str);
-            port->protocol = type;
+            port->protocol = lookup_protocol(type).name;
 
             if (p.contains("parameters")) {
                 for (auto& [k, v] : p["parameters"].items()) {
@@ -46,6 +48,53 @@ static void populate_port_map(const json& j,
     }
 }
 
+json load_component_spec(const std::string& spec_path) {
+    std::ifstream in(spec_path);
+    if (!in) {
+        throw std::runtime_error("Unable to open component spec " + spec_path);
+    }
+    json spec;
+    in >> spec;
+    return spec;
+}
+
+Component parse_component_entry(const json& c) {
+    Component comp;
+
+    comp.name      = c.at("name").get<std::string>();
+    comp.spec_path = c.at("spec_path").get<std::string>();
+    comp.src_path  = c.at("src_path").get<std::string>();
+
+    if (c.contains("parameters")) {
+        for (const auto& [k, v] : c["parameters"].items()) {
+            comp.parameters[k] = std::stoi(v.dump());
+        }
+    }
+
+    return comp;
+}
+
+void parse_component_spec(const json& spec, Component& comp) {
+    populate_port_map(spec, comp.ports);
+}
+
+std::vector<std::string> parse_spec_parameters(const json& spec) {
+    std::vector<std::string> names;
+    if (spec.contains("parameters")) {
+        for (const auto& p : spec.at("parameters")) {
+            names.push_back(p.get<std::string>());
+        }
+    }
+    return names;
+}
+
+void check_spec_parameter(const Component& comp, const std::string& param, const std::vector<std::string>& declared) {
+    if (std::find(declared.begin(), declared.end(), param) == declared.end()) {
+        throw std::runtime_error("Component " + comp.name + " has no parameter " + param
+                                 + " (not declared in " + comp.spec_path + ")");
+    }
+}
+
 void parse_interface_ports(const json& j, SystemIR& sys) {
     populate_port_map(j, sys.ports);
 }
@@ -55,27 +104,14 @@ void parse_components(const json& j, SystemIR& sys) {
         return;
 
     for (const auto& c : j.at("components")) {
-        Component comp;
-
-        comp.name      = c.at("name").get<std::string>();
-        comp.spec_path = c.at("spec_path").get<std::string>();
-        comp.src_path  = c.at("src_path").get<std::string>();
-
-        if (c.contains("parameters")) {
-            for (const auto& [k, v] : c["parameters"].items()) {
-                comp.parameters[k] = std::stoi(v.dump());
-            }
-        }
+        Component comp = parse_component_entry(c);
 
         // load the spec file itself so we know what ports this instance has
-        {
-            std::ifstream in(comp.spec_path);
-            if (!in) {
-                throw std::runtime_error("Unable to open component spec " + comp.spec_path);
-            }
-            json spec;
-            in >> spec;
-            populate_port_map(spec, comp.ports);
+        const json spec = load_component_spec(comp.spec_path);
+        parse_component_spec(spec, comp);
+        const std::vector<std::string> declared = parse_spec_parameters(spec);
+        for (const auto& [param, value] : comp.parameters) {
+            check_spec_parameter(comp, param, declared);
         }
 
         // Sanity: no duplicate instance names
@@ -89,27 +125,6 @@ void parse_components(const json& j, SystemIR& sys) {
     }
 }
 
-// helper used after all components/ports are in place to resolve endpoints
-static Port* resolve_endpoint(const SystemIR& sys, EndpointRef& ep) {
-    if (ep.instance == "this") {
-        auto it = sys.ports.find(ep.port);
-        if (it == sys.ports.end()) {
-            throw std::runtime_error("No such top-level port: " + ep.port);
-        }
-        return it->second.get();
-    }
-
-    auto cit = sys.components.find(ep.instance);
-    if (cit == sys.components.end()) {
-        throw std::runtime_error("Unknown component instance: " + ep.instance);
-    }
-    auto pit = cit->second.ports.find(ep.port);
-    if (pit == cit->second.ports.end()) {
-        throw std::runtime_error("Component '" + ep.instance + "' has no port '" + ep.port + "'");
-    }
-    return pit->second.get();
-}
-
 void parse_connections(const json& j, SystemIR& sys) {
     if (!j.contains("connections")) {
         return;
@@ -119,6 +134,11 @@ void parse_connections(const json& j, SystemIR& sys) {
         Connection c;
         c.name = jc.at("name").get<std::string>();
 
+        // Sanity: no duplicate connection names
+        if (find_connection(sys, c.name)) {
+            throw std::runtime_error("Duplicate connection name: " + c.name);
+        }
+
         const auto& destinations = jc.at("dsts");
 
         c.src = EndpointRef::parse(jc.at("src").get<std::string>());
@@ -127,12 +147,59 @@ void parse_connections(const json& j, SystemIR& sys) {
             c.dsts.push_back(EndpointRef::parse(dst_str.get<std::string>()));
         }
 
+        if (jc.contains("link")) {
+            const auto& jl = jc.at("link");
+            c.link.fifo_depth      = jl.value("fifo_depth", 0u);
+            c.link.pipeline_stages = jl.value("pipeline_stages", 0u);
+        }
+
         // resolve the port pointers immediately
         c.src.port_ptr = resolve_endpoint(sys, c.src);
         for (auto& dst : c.dsts) {
             dst.port_ptr = resolve_endpoint(sys, dst);
         }
+        check_connection(c);
+        if (c.link.buffered()) {
+            check_linkable(c);
+        }
 
         sys.connections.push_back(std::move(c));
     }
 }
+
+// addresses may be given as JSON numbers or as strings such as "0x4000_0000"
+static uint64_t parse_address(const json& v) {
+    if (v.is_number_unsigned() || v.is_number_integer()) {
+        return v.get<uint64_t>();
+    }
+    std::string s = v.get<std::string>();
+    s.erase(std::remove(s.begin(), s.end(), '_'), s.end());
+    return std::stoull(s, nullptr, 0);
+}
+
+void parse_interconnects(const json& j, SystemIR& sys) {
+    if (!j.contains("interconnects")) {
+        return;
+    }
+
+    for (const auto& ji : j.at("interconnects")) {
+        Interconnect ic;
+        ic.name = ji.at("name").get<std::string>();
+        ic.protocol = ji.at("protocol").get<std::string>();
+        ic.max_outstanding = ji.value("max_outstanding", ic.max_outstanding);
+
+        for (const auto& m : ji.at("masters")) {
+            ic.masters.push_back(EndpointRef::parse(m.get<std::string>()));
+        }
+        for (const auto& s : ji.at("slaves")) {
+            AddressWindow w;
+            w.port = EndpointRef::parse(s.at("port").get<std::string>());
+            w.base = parse_address(s.at("base"));
+            w.size = parse_address(s.at("size"));
+            ic.slaves.push_back(std::move(w));
+        }
+
+        resolve_interconnect(sys, ic);
+        sys.interconnects.push_back(std::move(ic));
+    }
+}
@@ -1,9 +1,24 @@
 #pragma once
 
+#include <string>
+#include <vector>
 #include "system_ir.hpp"
 #include "../third_party/json.hpp"
 using json = nlohmann::json;
 
+// Read a component specification JSON from disk.
+json load_component_spec(const std::string& spec_path);
+// Parse one entry of the "components" array (name, paths, parameter
+// overrides); ports are filled in separately from the spec.
+Component parse_component_entry(const json& c);
+// Fill comp.ports from an already loaded component specification.
+void parse_component_spec(const json& spec, Component& comp);
+// Names listed in the "parameters" array of a component specification.
+std::vector<std::string> parse_spec_parameters(const json& spec);
+// Throw unless param is one of the parameters declared by comp's spec.
+void check_spec_parameter(const Component& comp, const std::string& param, const std::vector<std::string>& declared);
+
 void parse_interface_ports(const json& j, SystemIR& sys);
 void parse_components(const json& j, SystemIR& sys);
-void parse_connections(const json& j, SystemIR& sys);
\ No newline at end of file
+void parse_connections(const json& j, SystemIR& sys);
+void parse_interconnects(const json& j, SystemIR& sys);
\ No newline at end of file
@@ -24,4 +24,39 @@ std::string to_string(PortMode mode) {
         case PortMode::Slave:  return "slave";
     }
     return "unknown";
-}
\ No newline at end of file
+}
+
+static std::string trim(std::string s) {
+    s.erase(0, s.find_first_not_of(" \t\n\r"));
+    s.erase(s.find_last_not_of(" \t\n\r") + 1);
+    return s;
+}
+
+int resolve_interface_width(
+    const InterfacePort& p,
+    const std::string& width_param,
+    const std::unordered_map<std::string, int>* comp_parameters
+) {
+    auto pit = p.parameters.find(width_param);
+    if (pit == p.parameters.end()) {
+        throw std::runtime_error(width_param + " parameter not found in interface port " + p.name);
+    }
+    const std::string width_str = trim(pit->second);
+    if (comp_parameters) {
+        auto it = comp_parameters->find(width_str);
+        if (it != comp_parameters->end()) {
+            return it->second;
+        }
+    }
+    size_t used = 0;
+    int width = 0;
+    try {
+        width = std::stoi(width_str, &used);
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (used == 0 || used != width_str.size()) {
+        throw std::runtime_error("Cannot resolve " + width_param + " '" + width_str + "' of interface port " + p.name);
+    }
+    return width;
+}
@@ -13,11 +13,15 @@ struct Port {
     PortType type;
     PortMode mode;
     virtual ~Port() = default;
+
+    // deep copy preserving the concrete port kind
+    virtual std::unique_ptr<Port> clone() const = 0;
 };
 
 struct WirePort : public Port {
     unsigned width = 1;
     WirePort() { type = PortType::Wire; }
+    std::unique_ptr<Port> clone() const override { return std::make_unique<WirePort>(*this); }
 };
 
 struct InterfacePort : public Port {
@@ -25,9 +29,19 @@ struct InterfacePort : public Port {
     std::unordered_map<std::string, std::string> parameters;
     std::unordered_map<std::string, std::string> port_maps;
     InterfacePort() { type = PortType::Interface; }
+    std::unique_ptr<Port> clone() const override { return std::make_unique<InterfacePort>(*this); }
 };
 
 // -------------------- Helpers --------------------
 PortMode parse_mode(const std::string& s);
 std::string to_string(PortType type);
-std::string to_string(PortMode mode);
\ No newline at end of file
+std::string to_string(PortMode mode);
+
+// Resolve a width parameter of an interface port (e.g. "tdata_width").  The
+// value is either a literal or the name of a parameter of the owning
+// component, looked up in comp_parameters when provided.
+int resolve_interface_width(
+    const InterfacePort& p,
+    const std::string& width_param,
+    const std::unordered_map<std::string, int>* comp_parameters = nullptr
+);
\ No newline at end of file
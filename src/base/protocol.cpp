@@ -0,0 +1,186 @@
+#include "protocol.hpp"
+
+#include <stdexcept>
+
+const ProtocolSignal* ProtocolDescriptor::find(const std::string& signal) const {
+    for (const auto& s : signals) {
+        if (s.name == signal) {
+            return &s;
+        }
+    }
+    return nullptr;
+}
+
+static constexpr bool kFromMaster = true;
+static constexpr bool kFromSlave  = false;
+
+// Signal of a fixed width.
+static ProtocolSignal fixed(const std::string& name, bool from_master, unsigned width = 1) {
+    ProtocolSignal sig;
+    sig.name = name;
+    sig.from_master = from_master;
+    sig.width = width;
+    return sig;
+}
+
+// Signal whose width is an interface parameter, divided by div.
+static ProtocolSignal param(const std::string& name, bool from_master, const std::string& width_param, unsigned div = 1) {
+    ProtocolSignal sig;
+    sig.name = name;
+    sig.from_master = from_master;
+    sig.width_param = width_param;
+    sig.width_div = div;
+    return sig;
+}
+
+static ProtocolSignal required(ProtocolSignal sig) {
+    sig.required = true;
+    return sig;
+}
+
+static ProtocolSignal tied(ProtocolSignal sig, long long value) {
+    sig.tie = value;
+    return sig;
+}
+
+static ProtocolDescriptor axi_stream_protocol() {
+    return {"axi_stream", {
+        required(param("tdata", kFromMaster, "tdata_width")),
+        required(fixed("tvalid", kFromMaster)),
+        tied(fixed("tready", kFromSlave), 1),
+        tied(fixed("tlast", kFromMaster), 1),
+        param("tdest", kFromMaster, "tdest_width"),
+        param("tid",   kFromMaster, "tid_width"),
+        param("tuser", kFromMaster, "tuser_width"),
+        tied(param("tkeep", kFromMaster, "tdata_width", 8), -1),
+        tied(param("tstrb", kFromMaster, "tdata_width", 8), -1),
+    }};
+}
+
+// AXI4 channels.  Sideband signals may be left unmapped and are tied to
+// their AXI defaults (INCR bursts, single-beat lengths).  The ties of
+// required signals apply to AXI4-Lite endpoints of an AXI4 crossbar.
+static ProtocolDescriptor axi4_protocol() {
+    return {"axi4", {
+        param("awid", kFromMaster, "id_width"),
+        required(param("awaddr", kFromMaster, "addr_width")),
+        required(fixed("awlen", kFromMaster, 8)),
+        required(fixed("awsize", kFromMaster, 3)),
+        tied(required(fixed("awburst", kFromMaster, 2)), 1),
+        fixed("awlock",  kFromMaster, 1),
+        fixed("awcache", kFromMaster, 4),
+        fixed("awprot",  kFromMaster, 3),
+        fixed("awqos",   kFromMaster, 4),
+        required(fixed("awvalid", kFromMaster)),
+        required(fixed("awready", kFromSlave)),
+        required(param("wdata", kFromMaster, "data_width")),
+        tied(param("wstrb", kFromMaster, "data_width", 8), -1),
+        tied(required(fixed("wlast", kFromMaster)), 1),
+        required(fixed("wvalid", kFromMaster)),
+        required(fixed("wready", kFromSlave)),
+        param("bid", kFromSlave, "id_width"),
+        fixed("bresp", kFromSlave, 2),
+        required(fixed("bvalid", kFromSlave)),
+        required(fixed("bready", kFromMaster)),
+        param("arid", kFromMaster, "id_width"),
+        required(param("araddr", kFromMaster, "addr_width")),
+        required(fixed("arlen", kFromMaster, 8)),
+        required(fixed("arsize", kFromMaster, 3)),
+        tied(required(fixed("arburst", kFromMaster, 2)), 1),
+        fixed("arlock",  kFromMaster, 1),
+        fixed("arcache", kFromMaster, 4),
+        fixed("arprot",  kFromMaster, 3),
+        fixed("arqos",   kFromMaster, 4),
+        required(fixed("arvalid", kFromMaster)),
+        required(fixed("arready", kFromSlave)),
+        param("rid", kFromSlave, "id_width"),
+        required(param("rdata", kFromSlave, "data_width")),
+        fixed("rresp", kFromSlave, 2),
+        tied(required(fixed("rlast", kFromSlave)), 1),
+        required(fixed("rvalid", kFromSlave)),
+        required(fixed("rready", kFromMaster)),
+    }};
+}
+
+static ProtocolDescriptor axi4_lite_protocol() {
+    return {"axi4_lite", {
+        required(param("awaddr", kFromMaster, "addr_width")),
+        fixed("awprot", kFromMaster, 3),
+        required(fixed("awvalid", kFromMaster)),
+        required(fixed("awready", kFromSlave)),
+        required(param("wdata", kFromMaster, "data_width")),
+        tied(param("wstrb", kFromMaster, "data_width", 8), -1),
+        required(fixed("wvalid", kFromMaster)),
+        required(fixed("wready", kFromSlave)),
+        fixed("bresp", kFromSlave, 2),
+        required(fixed("bvalid", kFromSlave)),
+        required(fixed("bready", kFromMaster)),
+        required(param("araddr", kFromMaster, "addr_width")),
+        fixed("arprot", kFromMaster, 3),
+        required(fixed("arvalid", kFromMaster)),
+        required(fixed("arready", kFromSlave)),
+        required(param("rdata", kFromSlave, "data_width")),
+        fixed("rresp", kFromSlave, 2),
+        required(fixed("rvalid", kFromSlave)),
+        required(fixed("rready", kFromMaster)),
+    }};
+}
+
+static std::unordered_map<std::string, ProtocolDescriptor>& registry() {
+    static std::unordered_map<std::string, ProtocolDescriptor> protocols = [] {
+        std::unordered_map<std::string, ProtocolDescriptor> m;
+        for (auto desc : {axi_stream_protocol(), axi4_protocol(), axi4_lite_protocol()}) {
+            m.emplace(desc.name, std::move(desc));
+        }
+        return m;
+    }();
+    return protocols;
+}
+
+const ProtocolDescriptor& lookup_protocol(const std::string& name) {
+    auto it = registry().find(name);
+    if (it == registry().end()) {
+        throw std::runtime_error("Unsupported interface protocol: " + name);
+    }
+    return it->second;
+}
+
+void register_protocol(ProtocolDescriptor desc) {
+    std::string name = desc.name;
+    registry()[name] = std::move(desc);
+}
+
+void check_required_signals(const InterfacePort& p, const ProtocolDescriptor& proto, const std::string& instance) {
+    for (const auto& sig : proto.signals) {
+        if (sig.required && !p.port_maps.count(sig.name)) {
+            throw std::runtime_error("Interface port " + (instance.empty() ? "" : instance + ".") + p.name
+                                     + " does not map required " + proto.name + " signal " + sig.name);
+        }
+    }
+}
+
+int signal_width(
+    const InterfacePort& p,
+    const ProtocolSignal& sig,
+    const std::unordered_map<std::string, int>* comp_parameters
+) {
+    if (sig.width_param.empty()) {
+        return static_cast<int>(sig.width);
+    }
+    return resolve_interface_width(p, sig.width_param, comp_parameters) / static_cast<int>(sig.width_div);
+}
+
+std::string signal_range_sv(const InterfacePort& p, const ProtocolSignal& sig) {
+    if (sig.width_param.empty()) {
+        return sig.width > 1 ? "[" + std::to_string(sig.width) + "-1:0]" : "";
+    }
+    auto it = p.parameters.find(sig.width_param);
+    if (it == p.parameters.end()) {
+        throw std::runtime_error(sig.width_param + " parameter not found in interface port " + p.name);
+    }
+    std::string expr = it->second;
+    if (sig.width_div != 1) {
+        expr += "/" + std::to_string(sig.width_div);
+    }
+    return "[" + expr + "-1:0]";
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "port.hpp"
+
+// One signal of an interface protocol, named by its port_maps key.
+struct ProtocolSignal {
+    std::string name;          // e.g. "tdata", "awaddr"
+    bool from_master;          // driven by the master side of the interface
+    std::string width_param;   // interface parameter holding the width; empty: fixed width
+    unsigned width = 1;        // fixed width when width_param is empty
+    unsigned width_div = 1;    // divisor applied to width_param (e.g. strobes)
+    bool required = false;     // endpoints of this protocol must map the signal
+    long long tie = 0;         // value driven into an unmapped input; -1: all ones
+};
+
+struct ProtocolDescriptor {
+    std::string name;
+    std::vector<ProtocolSignal> signals;
+
+    const ProtocolSignal* find(const std::string& signal) const;
+};
+
+// Registered protocols, keyed by the "type" used in interface_ports.
+// axi_stream, axi4 and axi4_lite are built in.  Registration is not
+// synchronised; register custom protocols before generating in parallel.
+const ProtocolDescriptor& lookup_protocol(const std::string& name);
+void register_protocol(ProtocolDescriptor desc);
+
+// Throw unless the port maps every signal the protocol marks as required.
+// instance names the component owning the port; empty for top-level ports.
+void check_required_signals(const InterfacePort& p, const ProtocolDescriptor& proto, const std::string& instance = "");
+
+// Width in bits of one signal of an interface port.
+int signal_width(
+    const InterfacePort& p,
+    const ProtocolSignal& sig,
+    const std::unordered_map<std::string, int>* comp_parameters = nullptr
+);
+
+// SV range expression for a signal of a top-level port ("" for one bit).
+std::string signal_range_sv(const InterfacePort& p, const ProtocolSignal& sig);
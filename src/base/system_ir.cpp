@@ -0,0 +1,75 @@
+#include "system_ir.hpp"
+
+#include <stdexcept>
+
+Port* resolve_endpoint(const SystemIR& sys, const EndpointRef& ep) {
+    if (ep.instance == "this") {
+        auto it = sys.ports.find(ep.port);
+        if (it == sys.ports.end()) {
+            throw std::runtime_error("No such top-level port: " + ep.port);
+        }
+        return it->second.get();
+    }
+
+    auto cit = sys.components.find(ep.instance);
+    if (cit == sys.components.end()) {
+        throw std::runtime_error("Unknown component instance: " + ep.instance);
+    }
+    auto pit = cit->second.ports.find(ep.port);
+    if (pit == cit->second.ports.end()) {
+        throw std::runtime_error("Component '" + ep.instance + "' has no port '" + ep.port + "'");
+    }
+    return pit->second.get();
+}
+
+const Connection* find_connection(const SystemIR& sys, const std::string& name) {
+    for (const auto& c : sys.connections) {
+        if (c.name == name) {
+            return &c;
+        }
+    }
+    return nullptr;
+}
+
+Connection* find_connection(SystemIR& sys, const std::string& name) {
+    return const_cast<Connection*>(find_connection(static_cast<const SystemIR&>(sys), name));
+}
+
+SystemIR clone_system(const SystemIR& sys) {
+    SystemIR copy;
+
+    copy.ports.reserve(sys.ports.size());
+    for (const auto& [name, port] : sys.ports) {
+        copy.ports.emplace(name, port->clone());
+    }
+
+    copy.components.reserve(sys.components.size());
+    for (const auto& [name, comp] : sys.components) {
+        Component c;
+        c.name        = comp.name;
+        c.spec_path   = comp.spec_path;
+        c.src_path    = comp.src_path;
+        c.module_name = comp.module_name;
+        c.parameters  = comp.parameters;
+        c.ports.reserve(comp.ports.size());
+        for (const auto& [port_name, port] : comp.ports) {
+            c.ports.emplace(port_name, port->clone());
+        }
+        copy.components.emplace(name, std::move(c));
+    }
+
+    copy.connections = sys.connections;
+    for (auto& conn : copy.connections) {
+        conn.src.port_ptr = resolve_endpoint(copy, conn.src);
+        for (auto& dst : conn.dsts) {
+            dst.port_ptr = resolve_endpoint(copy, dst);
+        }
+    }
+
+    copy.interconnects = sys.interconnects;
+    for (auto& ic : copy.interconnects) {
+        resolve_interconnect(copy, ic);
+    }
+
+    return copy;
+}
@@ -5,6 +5,7 @@
 #include "port.hpp"
 #include "component.hpp"
 #include "connections.hpp"
+#include "interconnect.hpp"
 #include <string>
 #include <vector>
 
@@ -12,4 +13,17 @@ struct SystemIR {
     std::unordered_map<std::string, std::unique_ptr<Port>> ports;
     std::unordered_map<std::string, Component> components;
     std::vector<Connection> connections;
-};
\ No newline at end of file
+    std::vector<Interconnect> interconnects;
+};
+
+// Look up the Port an endpoint refers to ("this" names a top-level port).
+// Throws if the instance or port does not exist.
+Port* resolve_endpoint(const SystemIR& sys, const EndpointRef& ep);
+
+// Connection with the given name, or nullptr.
+Connection* find_connection(SystemIR& sys, const std::string& name);
+const Connection* find_connection(const SystemIR& sys, const std::string& name);
+
+// Deep copy of a system.  Connection endpoints are re-resolved so that they
+// point into the copy rather than the original.
+SystemIR clone_system(const SystemIR& sys);
@@ -0,0 +1,117 @@
+#include "estimator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <set>
+#include <utility>
+
+static constexpr double kBaseFmaxMhz       = 400.0;
+static constexpr double kRouteWidthBits    = 256.0;
+static constexpr unsigned kLutRamMaxBits   = 2048;   // larger FIFOs map to BRAM
+static constexpr unsigned kBramBits        = 36864;
+static constexpr double kBramCost          = 500.0;  // LUT-equivalents per BRAM
+
+static const std::unordered_map<std::string, int>* params_of(const SystemIR& sys, const std::string& instance) {
+    if (instance == "this") {
+        return nullptr;
+    }
+    return &sys.components.at(instance).parameters;
+}
+
+static unsigned latency_of(const SystemIR& sys, const std::string& instance) {
+    const auto* params = params_of(sys, instance);
+    if (!params) {
+        return 0;
+    }
+    unsigned latency = 0;
+    const std::string suffix = "_LATENCY";
+    for (const auto& [name, value] : *params) {
+        if (name.size() >= suffix.size() &&
+            name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0 && value > 0) {
+            latency += static_cast<unsigned>(value);
+        }
+    }
+    return latency;
+}
+
+static unsigned stream_width(const InterfacePort& ip, const std::unordered_map<std::string, int>* params) {
+    unsigned width = static_cast<unsigned>(resolve_interface_width(ip, "tdata_width", params));
+    if (ip.port_maps.count("tdest")) {
+        width += static_cast<unsigned>(resolve_interface_width(ip, "tdest_width", params));
+    }
+    return width + 1;  // tlast
+}
+
+Estimate estimate_system(const SystemIR& sys) {
+    Estimate est;
+
+    double fmax = kBaseFmaxMhz;
+    double bottleneck_bytes = std::numeric_limits<double>::infinity();
+
+    for (const auto& conn : sys.connections) {
+        if (conn.link.buffered()) {
+            check_linkable(conn);  // only single-destination stream links are generated
+        }
+        if (conn.src.port_ptr->type != PortType::Interface) {
+            continue;
+        }
+        const auto* ip = static_cast<const InterfacePort*>(conn.src.port_ptr);
+        if (ip->protocol != "axi_stream") {
+            continue;
+        }
+
+        const auto* src_params = params_of(sys, conn.src.instance);
+        const double data_bits = resolve_interface_width(*ip, "tdata_width", src_params);
+        const unsigned bits = stream_width(*ip, src_params);
+        const LinkConfig& link = conn.link;
+
+        for (const auto& dst : conn.dsts) {
+            fmax = std::min(fmax, kBaseFmaxMhz / (1.0 + data_bits / (kRouteWidthBits * (1 + link.pipeline_stages))));
+
+            const double latency = latency_of(sys, dst.instance);
+            const double efficiency = std::min(1.0, (link.fifo_depth + 1.0) / (latency + 1.0));
+            bottleneck_bytes = std::min(bottleneck_bytes, data_bits / 8.0 * efficiency);
+
+            est.ffs += (bits + 1) * link.pipeline_stages;  // data + valid per stage
+            if (link.fifo_depth > 0) {
+                const unsigned fifo_bits = bits * link.fifo_depth;
+                if (fifo_bits <= kLutRamMaxBits) {
+                    est.luts += bits * ((link.fifo_depth + 31) / 32);
+                } else {
+                    est.brams += (fifo_bits + kBramBits - 1) / kBramBits;
+                }
+                const unsigned ptr_bits = static_cast<unsigned>(std::ceil(std::log2(link.fifo_depth + 1.0)));
+                est.ffs += 3 * ptr_bits + 1;
+                est.luts += 4 * ptr_bits;
+            }
+        }
+    }
+
+    // datapath registers of every connected component stream port; ports
+    // left unconnected may keep widths that are only defined in the SV
+    std::set<std::pair<std::string, std::string>> counted;
+    auto count_port = [&](const EndpointRef& ep) {
+        if (ep.instance == "this" || ep.port_ptr->type != PortType::Interface) {
+            return;
+        }
+        const auto* ip = static_cast<const InterfacePort*>(ep.port_ptr);
+        if (ip->protocol == "axi_stream" && counted.emplace(ep.instance, ep.port).second) {
+            est.ffs += stream_width(*ip, params_of(sys, ep.instance));
+        }
+    };
+    for (const auto& conn : sys.connections) {
+        count_port(conn.src);
+        for (const auto& dst : conn.dsts) {
+            count_port(dst);
+        }
+    }
+
+    if (bottleneck_bytes == std::numeric_limits<double>::infinity()) {
+        bottleneck_bytes = 0.0;
+    }
+    est.fmax_mhz = fmax;
+    est.throughput_mbps = bottleneck_bytes * fmax;
+    est.cost = est.luts + est.ffs + est.brams * kBramCost;
+    return est;
+}
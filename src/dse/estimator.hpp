@@ -0,0 +1,23 @@
+#pragma once
+
+#include "../base/system_ir.hpp"
+
+// First-order estimate of a system's interconnect, used to rank sweep
+// variants.  Only axi_stream connections are modelled:
+//   * each link limits the clock to BASE_FMAX / (1 + width / (256 * (1 + stages))),
+//     i.e. wide links cost routing delay that pipeline stages win back
+//   * a link into a component with *_LATENCY parameters runs at
+//     min(1, (fifo_depth + 1) / (latency + 1)) efficiency
+//   * throughput is that of the slowest link at the slowest link's clock
+// Resource cost counts link registers, FIFO storage (LUTRAM or BRAM) and the
+// stream datapath registers of each connected component port.
+struct Estimate {
+    double fmax_mhz = 0.0;
+    double throughput_mbps = 0.0;   // MB/s through the bottleneck link
+    unsigned luts = 0;
+    unsigned ffs = 0;
+    unsigned brams = 0;             // 36Kb blocks
+    double cost = 0.0;              // luts + ffs + weighted brams
+};
+
+Estimate estimate_system(const SystemIR& sys);
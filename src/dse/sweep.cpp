@@ -0,0 +1,268 @@
+#include "sweep.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+static std::vector<int> parse_range(const json& r, const std::string& what) {
+    std::vector<int> values;
+    if (r.is_array()) {
+        for (const auto& v : r) {
+            values.push_back(v.get<int>());
+        }
+    } else if (r.is_number_integer()) {
+        values.push_back(r.get<int>());
+    } else if (r.is_object()) {
+        const int lo = r.at("min").get<int>();
+        const int hi = r.at("max").get<int>();
+        if (r.contains("factor")) {
+            const int factor = r.at("factor").get<int>();
+            if (factor < 2 || lo <= 0) {
+                throw std::runtime_error("Invalid multiplicative range for " + what);
+            }
+            for (long v = lo; v <= hi; v *= factor) {
+                values.push_back(static_cast<int>(v));
+            }
+        } else {
+            const int step = r.value("step", 1);
+            if (step <= 0) {
+                throw std::runtime_error("Invalid step in range for " + what);
+            }
+            for (int v = lo; v <= hi; v += step) {
+                values.push_back(v);
+            }
+        }
+    } else {
+        throw std::runtime_error("Invalid range for " + what);
+    }
+
+    if (values.empty()) {
+        throw std::runtime_error("Empty range for " + what);
+    }
+    return values;
+}
+
+size_t SweepSpec::num_points() const {
+    size_t n = 1;
+    for (const auto& axis : axes) {
+        n *= axis.values.size();
+    }
+    return n;
+}
+
+SweepSpec parse_sweep_spec(const json& j) {
+    SweepSpec spec;
+    spec.system_path = j.at("system").get<std::string>();
+    spec.module_name = j.value("module_name", spec.module_name);
+    spec.output_dir  = j.value("output_dir", spec.output_dir);
+    spec.threads     = j.value("threads", 0u);
+
+    if (j.contains("parameters")) {
+        for (const auto& [target, range] : j.at("parameters").items()) {
+            if (target.find('.') == std::string::npos) {
+                throw std::runtime_error("Sweep parameter must be instance.PARAM: " + target);
+            }
+            spec.axes.push_back({SweepAxis::Kind::Parameter, target, parse_range(range, target)});
+        }
+    }
+
+    if (j.contains("links")) {
+        for (const auto& [conn, knobs] : j.at("links").items()) {
+            for (const auto& [knob, range] : knobs.items()) {
+                SweepAxis::Kind kind;
+                if (knob == "width")                kind = SweepAxis::Kind::LinkWidth;
+                else if (knob == "fifo_depth")      kind = SweepAxis::Kind::FifoDepth;
+                else if (knob == "pipeline_stages") kind = SweepAxis::Kind::PipelineStages;
+                else throw std::runtime_error("Unknown link knob '" + knob + "' for connection " + conn);
+                spec.axes.push_back({kind, conn, parse_range(range, conn + "." + knob)});
+            }
+        }
+    }
+
+    return spec;
+}
+
+void apply_sweep_point(SystemBuilder& variant, const SweepSpec& spec, const std::vector<int>& values) {
+    for (size_t a = 0; a < spec.axes.size(); ++a) {
+        const SweepAxis& axis = spec.axes[a];
+        const int v = values[a];
+        switch (axis.kind) {
+            case SweepAxis::Kind::Parameter: {
+                auto dot = axis.target.find('.');
+                variant.set_parameter(axis.target.substr(0, dot), axis.target.substr(dot + 1), v);
+                break;
+            }
+            case SweepAxis::Kind::LinkWidth:
+                variant.set_link_width(axis.target, v);
+                break;
+            case SweepAxis::Kind::FifoDepth:
+                variant.link(axis.target).fifo_depth = static_cast<unsigned>(v);
+                break;
+            case SweepAxis::Kind::PipelineStages:
+                variant.link(axis.target).pipeline_stages = static_cast<unsigned>(v);
+                break;
+        }
+    }
+}
+
+// mixed-radix decode of a point index, last axis varying fastest
+static std::vector<int> point_values(const SweepSpec& spec, size_t index) {
+    std::vector<int> values(spec.axes.size());
+    for (size_t a = spec.axes.size(); a-- > 0;) {
+        const auto& axis_values = spec.axes[a].values;
+        values[a] = axis_values[index % axis_values.size()];
+        index /= axis_values.size();
+    }
+    return values;
+}
+
+// a misspelled axis would fail every point; reject it before sweeping
+static void check_axis_targets(const SystemBuilder& base, const SweepSpec& spec) {
+    SystemBuilder probe = base.clone();
+    for (const auto& axis : spec.axes) {
+        switch (axis.kind) {
+            case SweepAxis::Kind::Parameter: {
+                auto dot = axis.target.find('.');
+                probe.set_parameter(axis.target.substr(0, dot), axis.target.substr(dot + 1), axis.values.front());
+                break;
+            }
+            case SweepAxis::Kind::LinkWidth:
+                if (!find_connection(probe.system(), axis.target)) {
+                    throw std::runtime_error("Unknown connection: " + axis.target);
+                }
+                break;
+            case SweepAxis::Kind::FifoDepth:
+            case SweepAxis::Kind::PipelineStages:
+                probe.link(axis.target);
+                break;
+        }
+    }
+}
+
+std::vector<SweepPoint> run_sweep(const SystemBuilder& base, const SweepSpec& spec) {
+    check_axis_targets(base, spec);
+
+    const size_t total = spec.num_points();
+    std::vector<SweepPoint> points(total);
+
+    unsigned nthreads = spec.threads ? spec.threads : std::thread::hardware_concurrency();
+    nthreads = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(nthreads ? nthreads : 1, total)));
+
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next++; i < total; i = next++) {
+            SweepPoint& pt = points[i];
+            pt.values = point_values(spec, i);
+            try {
+                SystemBuilder variant = base.clone();
+                apply_sweep_point(variant, spec, pt.values);
+                // only score variants that can actually be generated
+                std::ostringstream scratch;
+                variant.emit(scratch, spec.module_name);
+                pt.estimate = estimate_system(variant.system());
+            } catch (const std::exception& e) {
+                pt.error = e.what();
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < nthreads; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& th : pool) {
+        th.join();
+    }
+
+    return points;
+}
+
+std::vector<size_t> pareto_front(const std::vector<SweepPoint>& points) {
+    std::vector<size_t> order;
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (points[i].error.empty()) {
+            order.push_back(i);
+        }
+    }
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        const Estimate& ea = points[a].estimate;
+        const Estimate& eb = points[b].estimate;
+        if (ea.cost != eb.cost) return ea.cost < eb.cost;
+        return ea.throughput_mbps > eb.throughput_mbps;
+    });
+
+    std::vector<size_t> front;
+    double best = -1.0;
+    for (size_t i : order) {
+        if (points[i].estimate.throughput_mbps > best) {
+            best = points[i].estimate.throughput_mbps;
+            front.push_back(i);
+        }
+    }
+    return front;
+}
+
+const char* axis_kind_name(SweepAxis::Kind kind) {
+    switch (kind) {
+        case SweepAxis::Kind::Parameter:      return "parameter";
+        case SweepAxis::Kind::LinkWidth:      return "width";
+        case SweepAxis::Kind::FifoDepth:      return "fifo_depth";
+        case SweepAxis::Kind::PipelineStages: return "pipeline_stages";
+    }
+    return "unknown";
+}
+
+void write_sweep_results(
+    const SystemBuilder& base,
+    const SweepSpec& spec,
+    const std::vector<SweepPoint>& points,
+    const std::vector<size_t>& front
+) {
+    namespace fs = std::filesystem;
+    fs::create_directories(spec.output_dir);
+
+    json out = json::array();
+    for (size_t i : front) {
+        const SweepPoint& pt = points[i];
+        const std::string sv_name = "variant_" + std::to_string(i) + ".sv";
+
+        SystemBuilder variant = base.clone();
+        apply_sweep_point(variant, spec, pt.values);
+        std::ofstream sv(fs::path(spec.output_dir) / sv_name);
+        if (!sv) {
+            throw std::runtime_error("Unable to write " + sv_name + " in " + spec.output_dir);
+        }
+        variant.emit(sv, spec.module_name);
+
+        json jp;
+        jp["index"] = i;
+        jp["sv"] = sv_name;
+        json settings = json::array();
+        for (size_t a = 0; a < spec.axes.size(); ++a) {
+            settings.push_back({
+                {"kind", axis_kind_name(spec.axes[a].kind)},
+                {"target", spec.axes[a].target},
+                {"value", pt.values[a]}
+            });
+        }
+        jp["settings"] = settings;
+        jp["fmax_mhz"] = pt.estimate.fmax_mhz;
+        jp["throughput_mbps"] = pt.estimate.throughput_mbps;
+        jp["luts"] = pt.estimate.luts;
+        jp["ffs"] = pt.estimate.ffs;
+        jp["brams"] = pt.estimate.brams;
+        jp["cost"] = pt.estimate.cost;
+        out.push_back(jp);
+    }
+
+    std::ofstream pf(fs::path(spec.output_dir) / "pareto.json");
+    if (!pf) {
+        throw std::runtime_error("Unable to write pareto.json in " + spec.output_dir);
+    }
+    pf << out.dump(4) << "\n";
+}
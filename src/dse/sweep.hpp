@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "estimator.hpp"
+#include "../api/system_builder.hpp"
+
+// One dimension of a parameter sweep.
+struct SweepAxis {
+    enum class Kind { Parameter, LinkWidth, FifoDepth, PipelineStages };
+
+    Kind kind;
+    std::string target;   // "instance.PARAM" for parameters, else a connection name
+    std::vector<int> values;
+};
+
+// Key of the axis kind in sweep descriptions and pareto.json.
+const char* axis_kind_name(SweepAxis::Kind kind);
+
+struct SweepSpec {
+    std::string system_path;
+    std::string module_name = "top";
+    std::string output_dir = "sweep_out";
+    unsigned threads = 0;           // 0: one per hardware thread
+    std::vector<SweepAxis> axes;
+
+    size_t num_points() const;
+};
+
+struct SweepPoint {
+    std::vector<int> values;        // one per axis, in SweepSpec::axes order
+    Estimate estimate;
+    std::string error;              // set when the variant could not be built
+};
+
+// Parse a sweep description:
+//   { "system": "...", "module_name": "top", "output_dir": "...", "threads": 0,
+//     "parameters": { "inst.PARAM": <range> },
+//     "links": { "<connection>": { "width": <range>, "fifo_depth": <range>,
+//                                  "pipeline_stages": <range> } } }
+// where <range> is a single value, a list of values or {"min", "max"} with an
+// optional additive "step" (default 1) or multiplicative "factor".
+// Parameters must be declared in the component spec's "parameters" list.
+SweepSpec parse_sweep_spec(const json& j);
+
+// Apply the axis values of one sweep point to a variant.
+void apply_sweep_point(SystemBuilder& variant, const SweepSpec& spec, const std::vector<int>& values);
+
+// Build, generate and score every point of the sweep, spread over
+// spec.threads workers.  Points that fail get SweepPoint::error; an axis
+// naming an unknown instance, an undeclared parameter or a connection that
+// cannot carry a link throws before any point is built.
+std::vector<SweepPoint> run_sweep(const SystemBuilder& base, const SweepSpec& spec);
+
+// Indices of the points not dominated in (throughput up, cost down), ordered
+// by increasing cost.  Points with errors are ignored.
+std::vector<size_t> pareto_front(const std::vector<SweepPoint>& points);
+
+// Write pareto.json and one SV file per Pareto point into spec.output_dir.
+void write_sweep_results(
+    const SystemBuilder& base,
+    const SweepSpec& spec,
+    const std::vector<SweepPoint>& points,
+    const std::vector<size_t>& front
+);
@@ -1,11 +1,15 @@
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <cstring>
 
 #include "base/port.hpp"
 #include "base/parser.hpp"
 #include "base/system_ir.hpp"
 #include "base/connections.hpp"
 #include "svgen/sv_emitter.hpp"
+#include "api/system_builder.hpp"
+#include "dse/sweep.hpp"
 #include "third_party/json.hpp"
 using json = nlohmann::json;
 
@@ -67,9 +71,85 @@ void print_components(const SystemIR& sys) {
 }
 
 
+static bool load_json(const char* path, json& j) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Error: cannot open file " << path << "\n";
+        return false;
+    }
+    in >> j;
+    return true;
+}
+
+static int sweep_and_report(const char* sweep_path) {
+    json sj;
+    if (!load_json(sweep_path, sj)) {
+        return 1;
+    }
+    SweepSpec spec = parse_sweep_spec(sj);
+
+    json j;
+    if (!load_json(spec.system_path.c_str(), j)) {
+        return 1;
+    }
+    SystemBuilder base = SystemBuilder::from_json(j);
+
+    std::cout << "Sweeping " << spec.num_points() << " variants of " << spec.system_path << "\n";
+    std::vector<SweepPoint> points = run_sweep(base, spec);
+
+    size_t failed = 0;
+    for (const auto& pt : points) {
+        if (!pt.error.empty()) {
+            ++failed;
+        }
+    }
+    if (failed) {
+        std::cout << failed << " variants could not be built, e.g.: "
+                  << std::find_if(points.begin(), points.end(),
+                                  [](const SweepPoint& p) { return !p.error.empty(); })->error
+                  << "\n";
+    }
+
+    std::vector<size_t> front = pareto_front(points);
+
+    std::cout << "\nPareto front (" << front.size() << " points):\n";
+    for (size_t i : front) {
+        const SweepPoint& pt = points[i];
+        std::cout << "  variant_" << i << ":";
+        for (size_t a = 0; a < spec.axes.size(); ++a) {
+            std::cout << " " << spec.axes[a].target;
+            if (spec.axes[a].kind != SweepAxis::Kind::Parameter) {
+                std::cout << "." << axis_kind_name(spec.axes[a].kind);
+            }
+            std::cout << "=" << pt.values[a];
+        }
+        std::cout << "\n    throughput " << pt.estimate.throughput_mbps << " MB/s @ "
+                  << pt.estimate.fmax_mhz << " MHz, cost " << pt.estimate.cost
+                  << " (" << pt.estimate.luts << " LUT, " << pt.estimate.ffs << " FF, "
+                  << pt.estimate.brams << " BRAM)\n";
+    }
+
+    write_sweep_results(base, spec, points, front);
+    std::cout << "\nWrote Pareto SV and pareto.json to " << spec.output_dir << "\n";
+    return 0;
+}
+
+int run_sweep_mode(const char* sweep_path) {
+    try {
+        return sweep_and_report(sweep_path);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
+
 int main(int argc, char** argv) {
+    if (argc == 3 && std::strcmp(argv[1], "--sweep") == 0) {
+        return run_sweep_mode(argv[2]);
+    }
     if (argc != 2) {
-        std::cerr << "Usage: " << argv[0] << " <system.json>\n";
+        std::cerr << "Usage: " << argv[0] << " <system.json>\n"
+                  << "       " << argv[0] << " --sweep <sweep.json>\n";
         return 1;
     }
 
@@ -94,6 +174,11 @@ int main(int argc, char** argv) {
         std::cout << c << std::endl;
     }
 
+    parse_interconnects(j, system);
+    for (const auto& ic : system.interconnects) {
+        std::cout << ic << std::endl;
+    }
+
     std::string sv = emit_top_module_sv(system, "top");
 
     std::cout << "===== GENERATED SYSTEMVERILOG =====\n\n";
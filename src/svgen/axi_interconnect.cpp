@@ -0,0 +1,806 @@
+#include "axi_interconnect.hpp"
+#include "../base/protocol.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+
+// flowforge_axi_xbar is a full crossbar with one holding register per target
+// for AW and AR, independent read and write paths, and an internal slave
+// that answers unmapped addresses with DECERR.
+//
+//  * IDs are remapped by prefixing the master index, so slaves see
+//    SID_W = ID_W + MI_W bit IDs and responses route back on those bits.
+//    Slaves flagged in SLAVE_NO_ID (AXI4-Lite, or AXI4 without ID signals)
+//    return responses in order; those are routed through a per-target FIFO
+//    of master indices instead.
+//  * Each master may keep MAX_OUTSTANDING transactions in flight per
+//    direction, but only switches target once its earlier transactions in
+//    that direction have completed, which keeps responses in order without
+//    per-ID tracking.
+//  * Bursts pass through untouched.  Write data follows the AW grant order
+//    of each target and is only handed to the next master on WLAST; a read
+//    burst returns from a single target, so neither is ever interleaved.
+static const char kAxiInterconnectModules[] = R"SV(module flowforge_axi_fifo #(
+    parameter WIDTH = 1,
+    parameter DEPTH = 4
+)(
+    input  logic             aclk,
+    input  logic             aresetn,
+    input  logic             push,
+    input  logic [WIDTH-1:0] din,
+    input  logic             pop,
+    output logic [WIDTH-1:0] dout,
+    output logic             empty,
+    output logic             full
+);
+    localparam AW = (DEPTH > 1) ? $clog2(DEPTH) : 1;
+
+    logic [WIDTH-1:0] mem [0:DEPTH-1];
+    logic [AW-1:0]    wr_ptr, rd_ptr;
+    logic [AW:0]      count;
+
+    wire do_push = push && !full;
+    wire do_pop  = pop && !empty;
+
+    assign dout  = mem[rd_ptr];
+    assign empty = (count == 0);
+    assign full  = (count == DEPTH);
+
+    always_ff @(posedge aclk) begin
+        if (!aresetn) begin
+            wr_ptr <= '0;
+            rd_ptr <= '0;
+            count  <= '0;
+        end else begin
+            if (do_push) begin
+                mem[wr_ptr] <= din;
+                wr_ptr <= (wr_ptr == DEPTH-1) ? '0 : wr_ptr + 1'b1;
+            end
+            if (do_pop) begin
+                rd_ptr <= (rd_ptr == DEPTH-1) ? '0 : rd_ptr + 1'b1;
+            end
+            count <= count + do_push - do_pop;
+        end
+    end
+
+endmodule
+
+module flowforge_axi_err_slave #(
+    parameter ID_W   = 1,
+    parameter DATA_W = 32
+)(
+    input  logic              aclk,
+    input  logic              aresetn,
+
+    input  logic [ID_W-1:0]   awid,
+    input  logic              awvalid,
+    output logic              awready,
+    input  logic              wlast,
+    input  logic              wvalid,
+    output logic              wready,
+    output logic [ID_W-1:0]   bid,
+    output logic [1:0]        bresp,
+    output logic              bvalid,
+    input  logic              bready,
+
+    input  logic [ID_W-1:0]   arid,
+    input  logic [7:0]        arlen,
+    input  logic              arvalid,
+    output logic              arready,
+    output logic [ID_W-1:0]   rid,
+    output logic [DATA_W-1:0] rdata,
+    output logic [1:0]        rresp,
+    output logic              rlast,
+    output logic              rvalid,
+    input  logic              rready
+);
+    localparam logic [1:0] DECERR = 2'b11;
+
+    typedef enum logic [1:0] {
+        W_IDLE,
+        W_DATA,
+        W_RESP
+    } w_state_t;
+
+    w_state_t   w_state;
+    logic       r_busy;
+    logic [7:0] r_left;
+
+    assign awready = (w_state == W_IDLE);
+    assign wready  = (w_state == W_DATA);
+    assign bvalid  = (w_state == W_RESP);
+    assign bresp   = DECERR;
+
+    always_ff @(posedge aclk) begin
+        if (!aresetn) begin
+            w_state <= W_IDLE;
+        end else begin
+            case (w_state)
+                W_IDLE: if (awvalid) begin
+                    bid     <= awid;
+                    w_state <= W_DATA;
+                end
+                W_DATA: if (wvalid && wlast) w_state <= W_RESP;
+                W_RESP: if (bready) w_state <= W_IDLE;
+                default: w_state <= W_IDLE;
+            endcase
+        end
+    end
+
+    assign arready = !r_busy;
+    assign rvalid  = r_busy;
+    assign rdata   = '0;
+    assign rresp   = DECERR;
+    assign rlast   = (r_left == 0);
+
+    always_ff @(posedge aclk) begin
+        if (!aresetn) begin
+            r_busy <= 1'b0;
+        end else if (!r_busy) begin
+            if (arvalid) begin
+                r_busy <= 1'b1;
+                rid    <= arid;
+                r_left <= arlen;
+            end
+        end else if (rready) begin
+            if (r_left == 0) r_busy <= 1'b0;
+            else             r_left <= r_left - 1'b1;
+        end
+    end
+
+endmodule
+
+module flowforge_axi_xbar #(
+    parameter NM              = 1,
+    parameter NS              = 1,
+    parameter ADDR_W          = 32,
+    parameter DATA_W          = 64,
+    parameter ID_W            = 1,
+    parameter MAX_OUTSTANDING = 4,
+    parameter logic [NS-1:0] SLAVE_NO_ID = '0,
+    parameter logic [NS*ADDR_W-1:0] SLAVE_BASE = '0,
+    parameter logic [NS*ADDR_W-1:0] SLAVE_MASK = '0,
+    parameter MI_W            = (NM > 1) ? $clog2(NM) : 1,
+    parameter SID_W           = ID_W + MI_W
+)(
+    input  logic                     aclk,
+    input  logic                     aresetn,
+
+    // ---------------------------------
+    // Slave side (one per master)
+    // ---------------------------------
+    input  logic [NM*ID_W-1:0]       s_awid,
+    input  logic [NM*ADDR_W-1:0]     s_awaddr,
+    input  logic [NM*8-1:0]          s_awlen,
+    input  logic [NM*3-1:0]          s_awsize,
+    input  logic [NM*2-1:0]          s_awburst,
+    input  logic [NM-1:0]            s_awlock,
+    input  logic [NM*4-1:0]          s_awcache,
+    input  logic [NM*3-1:0]          s_awprot,
+    input  logic [NM*4-1:0]          s_awqos,
+    input  logic [NM-1:0]            s_awvalid,
+    output logic [NM-1:0]            s_awready,
+    input  logic [NM*DATA_W-1:0]     s_wdata,
+    input  logic [NM*DATA_W/8-1:0]   s_wstrb,
+    input  logic [NM-1:0]            s_wlast,
+    input  logic [NM-1:0]            s_wvalid,
+    output logic [NM-1:0]            s_wready,
+    output logic [NM*ID_W-1:0]       s_bid,
+    output logic [NM*2-1:0]          s_bresp,
+    output logic [NM-1:0]            s_bvalid,
+    input  logic [NM-1:0]            s_bready,
+    input  logic [NM*ID_W-1:0]       s_arid,
+    input  logic [NM*ADDR_W-1:0]     s_araddr,
+    input  logic [NM*8-1:0]          s_arlen,
+    input  logic [NM*3-1:0]          s_arsize,
+    input  logic [NM*2-1:0]          s_arburst,
+    input  logic [NM-1:0]            s_arlock,
+    input  logic [NM*4-1:0]          s_arcache,
+    input  logic [NM*3-1:0]          s_arprot,
+    input  logic [NM*4-1:0]          s_arqos,
+    input  logic [NM-1:0]            s_arvalid,
+    output logic [NM-1:0]            s_arready,
+    output logic [NM*ID_W-1:0]       s_rid,
+    output logic [NM*DATA_W-1:0]     s_rdata,
+    output logic [NM*2-1:0]          s_rresp,
+    output logic [NM-1:0]            s_rlast,
+    output logic [NM-1:0]            s_rvalid,
+    input  logic [NM-1:0]            s_rready,
+
+    // ---------------------------------
+    // Master side (one per slave)
+    // ---------------------------------
+    output logic [NS*SID_W-1:0]      m_awid,
+    output logic [NS*ADDR_W-1:0]     m_awaddr,
+    output logic [NS*8-1:0]          m_awlen,
+    output logic [NS*3-1:0]          m_awsize,
+    output logic [NS*2-1:0]          m_awburst,
+    output logic [NS-1:0]            m_awlock,
+    output logic [NS*4-1:0]          m_awcache,
+    output logic [NS*3-1:0]          m_awprot,
+    output logic [NS*4-1:0]          m_awqos,
+    output logic [NS-1:0]            m_awvalid,
+    input  logic [NS-1:0]            m_awready,
+    output logic [NS*DATA_W-1:0]     m_wdata,
+    output logic [NS*DATA_W/8-1:0]   m_wstrb,
+    output logic [NS-1:0]            m_wlast,
+    output logic [NS-1:0]            m_wvalid,
+    input  logic [NS-1:0]            m_wready,
+    input  logic [NS*SID_W-1:0]      m_bid,
+    input  logic [NS*2-1:0]          m_bresp,
+    input  logic [NS-1:0]            m_bvalid,
+    output logic [NS-1:0]            m_bready,
+    output logic [NS*SID_W-1:0]      m_arid,
+    output logic [NS*ADDR_W-1:0]     m_araddr,
+    output logic [NS*8-1:0]          m_arlen,
+    output logic [NS*3-1:0]          m_arsize,
+    output logic [NS*2-1:0]          m_arburst,
+    output logic [NS-1:0]            m_arlock,
+    output logic [NS*4-1:0]          m_arcache,
+    output logic [NS*3-1:0]          m_arprot,
+    output logic [NS*4-1:0]          m_arqos,
+    output logic [NS-1:0]            m_arvalid,
+    input  logic [NS-1:0]            m_arready,
+    input  logic [NS*SID_W-1:0]      m_rid,
+    input  logic [NS*DATA_W-1:0]     m_rdata,
+    input  logic [NS*2-1:0]          m_rresp,
+    input  logic [NS-1:0]            m_rlast,
+    input  logic [NS-1:0]            m_rvalid,
+    output logic [NS-1:0]            m_rready
+);
+    localparam NT     = NS + 1;               // target NS is the decode-error slave
+    localparam TI_W   = $clog2(NT);
+    localparam OT_W   = $clog2(MAX_OUTSTANDING + 1);
+    localparam QD     = NM * MAX_OUTSTANDING;
+    localparam STRB_W = DATA_W / 8;
+    localparam AP_W   = SID_W + ADDR_W + 25;  // {id, addr, len, size, burst, lock, cache, prot, qos}
+    localparam logic [NT-1:0] T_NO_ID = {1'b0, SLAVE_NO_ID};  // the decode-error slave echoes IDs
+
+    function automatic logic [TI_W-1:0] decode(input logic [ADDR_W-1:0] addr);
+        decode = TI_W'(NS);
+        for (int s = NS - 1; s >= 0; s--) begin
+            if ((addr & SLAVE_MASK[s*ADDR_W +: ADDR_W]) == SLAVE_BASE[s*ADDR_W +: ADDR_W])
+                decode = TI_W'(s);
+        end
+    endfunction
+
+    // -------------------------------------------
+    // Per-master decode and outstanding tracking
+    // -------------------------------------------
+    logic [TI_W-1:0] aw_tgt  [NM];
+    logic [TI_W-1:0] ar_tgt  [NM];
+    logic [TI_W-1:0] w_tgt_q [NM];
+    logic [TI_W-1:0] r_tgt_q [NM];
+    logic [OT_W-1:0] w_cnt   [NM];
+    logic [OT_W-1:0] r_cnt   [NM];
+    logic [AP_W-1:0] aw_pl   [NM];
+    logic [AP_W-1:0] ar_pl   [NM];
+    logic [NM-1:0]   aw_ok, ar_ok;
+
+    for (genvar m = 0; m < NM; m++) begin : g_master
+        wire aw_hs  = s_awvalid[m] && s_awready[m];
+        wire ar_hs  = s_arvalid[m] && s_arready[m];
+        wire b_hs   = s_bvalid[m] && s_bready[m];
+        wire r_done = s_rvalid[m] && s_rready[m] && s_rlast[m];
+
+        assign aw_tgt[m] = decode(s_awaddr[m*ADDR_W +: ADDR_W]);
+        assign ar_tgt[m] = decode(s_araddr[m*ADDR_W +: ADDR_W]);
+
+        assign aw_ok[m] = (w_cnt[m] == 0) || (w_tgt_q[m] == aw_tgt[m] && w_cnt[m] < MAX_OUTSTANDING);
+        assign ar_ok[m] = (r_cnt[m] == 0) || (r_tgt_q[m] == ar_tgt[m] && r_cnt[m] < MAX_OUTSTANDING);
+
+        assign aw_pl[m] = {MI_W'(m), s_awid[m*ID_W +: ID_W], s_awaddr[m*ADDR_W +: ADDR_W],
+                           s_awlen[m*8 +: 8], s_awsize[m*3 +: 3], s_awburst[m*2 +: 2], s_awlock[m],
+                           s_awcache[m*4 +: 4], s_awprot[m*3 +: 3], s_awqos[m*4 +: 4]};
+        assign ar_pl[m] = {MI_W'(m), s_arid[m*ID_W +: ID_W], s_araddr[m*ADDR_W +: ADDR_W],
+                           s_arlen[m*8 +: 8], s_arsize[m*3 +: 3], s_arburst[m*2 +: 2], s_arlock[m],
+                           s_arcache[m*4 +: 4], s_arprot[m*3 +: 3], s_arqos[m*4 +: 4]};
+
+        always_ff @(posedge aclk) begin
+            if (!aresetn) begin
+                w_cnt[m] <= '0;
+                r_cnt[m] <= '0;
+            end else begin
+                w_cnt[m] <= w_cnt[m] + aw_hs - b_hs;
+                r_cnt[m] <= r_cnt[m] + ar_hs - r_done;
+                if (aw_hs) w_tgt_q[m] <= aw_tgt[m];
+                if (ar_hs) r_tgt_q[m] <= ar_tgt[m];
+            end
+        end
+    end
+
+    // -------------------------------------------
+    // Per-target arbitration and channel muxing
+    // -------------------------------------------
+    logic [NT-1:0]     t_awvalid, t_awready, t_wvalid, t_wready, t_wlast;
+    logic [NT-1:0]     t_bvalid, t_bready, t_arvalid, t_arready;
+    logic [NT-1:0]     t_rvalid, t_rready, t_rlast;
+    logic [AP_W-1:0]   t_aw      [NT];
+    logic [AP_W-1:0]   t_ar      [NT];
+    logic [DATA_W-1:0] t_wdata   [NT];
+    logic [STRB_W-1:0] t_wstrb   [NT];
+    logic [SID_W-1:0]  t_bid     [NT];
+    logic [1:0]        t_bresp   [NT];
+    logic [SID_W-1:0]  t_rid     [NT];
+    logic [DATA_W-1:0] t_rdata   [NT];
+    logic [1:0]        t_rresp   [NT];
+    logic [NM-1:0]     aw_grant  [NT];
+    logic [NM-1:0]     ar_grant  [NT];
+    logic [MI_W-1:0]   b_master  [NT];
+    logic [MI_W-1:0]   r_master  [NT];
+    logic [MI_W-1:0]   wq_front  [NT];
+    logic [NT-1:0]     wq_empty;
+
+    for (genvar t = 0; t < NT; t++) begin : g_target
+        logic [NM-1:0]   aw_req, ar_req;
+        logic            aw_full, ar_full;
+        logic [AP_W-1:0] aw_q, ar_q;
+        logic [MI_W-1:0] aw_ptr, ar_ptr, aw_win, ar_win;
+        logic            aw_win_valid, ar_win_valid;
+        logic            aw_load, ar_load;
+        logic            wq_full, bq_full, rq_full;
+
+        for (genvar m = 0; m < NM; m++) begin : g_req
+            assign aw_req[m] = s_awvalid[m] && aw_ok[m] && (aw_tgt[m] == TI_W'(t));
+            assign ar_req[m] = s_arvalid[m] && ar_ok[m] && (ar_tgt[m] == TI_W'(t));
+        end
+
+        // round-robin winners, starting after the last granted master
+        always_comb begin
+            aw_win_valid = 1'b0;
+            aw_win       = '0;
+            ar_win_valid = 1'b0;
+            ar_win       = '0;
+            for (int k = 0; k < NM; k++) begin
+                automatic int aw_idx = (int'(aw_ptr) + k) % NM;
+                automatic int ar_idx = (int'(ar_ptr) + k) % NM;
+                if (!aw_win_valid && aw_req[aw_idx]) begin
+                    aw_win_valid = 1'b1;
+                    aw_win       = MI_W'(aw_idx);
+                end
+                if (!ar_win_valid && ar_req[ar_idx]) begin
+                    ar_win_valid = 1'b1;
+                    ar_win       = MI_W'(ar_idx);
+                end
+            end
+        end
+
+        // a request is taken when the holding register frees up this cycle
+        // and the ordering queues have room for it
+        wire aw_pop = aw_full && t_awready[t];
+        wire ar_pop = ar_full && t_arready[t];
+        assign aw_load = aw_win_valid && (!aw_full || aw_pop) && !wq_full && !bq_full;
+        assign ar_load = ar_win_valid && (!ar_full || ar_pop) && !rq_full;
+        assign aw_grant[t] = aw_load ? (NM'(1) << aw_win) : '0;
+        assign ar_grant[t] = ar_load ? (NM'(1) << ar_win) : '0;
+
+        always_ff @(posedge aclk) begin
+            if (!aresetn) begin
+                aw_full <= 1'b0;
+                ar_full <= 1'b0;
+                aw_ptr  <= '0;
+                ar_ptr  <= '0;
+            end else begin
+                if (aw_load) begin
+                    aw_full <= 1'b1;
+                    aw_q    <= aw_pl[aw_win];
+                    aw_ptr  <= (aw_win == MI_W'(NM - 1)) ? '0 : aw_win + 1'b1;
+                end else if (aw_pop) begin
+                    aw_full <= 1'b0;
+                end
+                if (ar_load) begin
+                    ar_full <= 1'b1;
+                    ar_q    <= ar_pl[ar_win];
+                    ar_ptr  <= (ar_win == MI_W'(NM - 1)) ? '0 : ar_win + 1'b1;
+                end else if (ar_pop) begin
+                    ar_full <= 1'b0;
+                end
+            end
+        end
+
+        assign t_awvalid[t] = aw_full;
+        assign t_aw[t]      = aw_q;
+        assign t_arvalid[t] = ar_full;
+        assign t_ar[t]      = ar_q;
+
+        // write data follows the AW grant order, one whole burst at a time
+        flowforge_axi_fifo #(
+            .WIDTH(MI_W),
+            .DEPTH(QD)
+        ) u_wq (
+            .aclk(aclk),
+            .aresetn(aresetn),
+            .push(aw_load),
+            .din(aw_win),
+            .pop(t_wvalid[t] && t_wready[t] && t_wlast[t]),
+            .dout(wq_front[t]),
+            .empty(wq_empty[t]),
+            .full(wq_full)
+        );
+
+        assign t_wvalid[t] = !wq_empty[t] && s_wvalid[wq_front[t]];
+        assign t_wdata[t]  = s_wdata[wq_front[t]*DATA_W +: DATA_W];
+        assign t_wstrb[t]  = s_wstrb[wq_front[t]*STRB_W +: STRB_W];
+        assign t_wlast[t]  = s_wlast[wq_front[t]];
+
+        if (T_NO_ID[t]) begin : g_order
+            flowforge_axi_fifo #(
+                .WIDTH(MI_W),
+                .DEPTH(QD)
+            ) u_bq (
+                .aclk(aclk),
+                .aresetn(aresetn),
+                .push(aw_load),
+                .din(aw_win),
+                .pop(t_bvalid[t] && t_bready[t]),
+                .dout(b_master[t]),
+                .empty(),
+                .full(bq_full)
+            );
+
+            flowforge_axi_fifo #(
+                .WIDTH(MI_W),
+                .DEPTH(QD)
+            ) u_rq (
+                .aclk(aclk),
+                .aresetn(aresetn),
+                .push(ar_load),
+                .din(ar_win),
+                .pop(t_rvalid[t] && t_rready[t] && t_rlast[t]),
+                .dout(r_master[t]),
+                .empty(),
+                .full(rq_full)
+            );
+        end else begin : g_id_route
+            assign bq_full     = 1'b0;
+            assign rq_full     = 1'b0;
+            assign b_master[t] = t_bid[t][SID_W-1 -: MI_W];
+            assign r_master[t] = t_rid[t][SID_W-1 -: MI_W];
+        end
+
+        assign t_bready[t] = s_bready[b_master[t]];
+        assign t_rready[t] = s_rready[r_master[t]];
+    end
+
+    // -------------------------------------------
+    // Master-side handshakes and response muxing
+    // -------------------------------------------
+    always_comb begin
+        s_awready = '0;
+        s_arready = '0;
+        s_wready  = '0;
+        s_bvalid  = '0;
+        s_bid     = '0;
+        s_bresp   = '0;
+        s_rvalid  = '0;
+        s_rid     = '0;
+        s_rdata   = '0;
+        s_rresp   = '0;
+        s_rlast   = '0;
+        for (int t = 0; t < NT; t++) begin
+            s_awready |= aw_grant[t];
+            s_arready |= ar_grant[t];
+            if (!wq_empty[t] && t_wready[t]) begin
+                s_wready[wq_front[t]] = 1'b1;
+            end
+            if (t_bvalid[t]) begin
+                s_bvalid[b_master[t]]                 = 1'b1;
+                s_bid[b_master[t]*ID_W +: ID_W]       = t_bid[t][ID_W-1:0];
+                s_bresp[b_master[t]*2 +: 2]           = t_bresp[t];
+            end
+            if (t_rvalid[t]) begin
+                s_rvalid[r_master[t]]                 = 1'b1;
+                s_rid[r_master[t]*ID_W +: ID_W]       = t_rid[t][ID_W-1:0];
+                s_rdata[r_master[t]*DATA_W +: DATA_W] = t_rdata[t];
+                s_rresp[r_master[t]*2 +: 2]           = t_rresp[t];
+                s_rlast[r_master[t]]                  = t_rlast[t];
+            end
+        end
+    end
+
+    // -------------------------------------------
+    // Target ports
+    // -------------------------------------------
+    for (genvar s = 0; s < NS; s++) begin : g_slave_port
+        assign {m_awid[s*SID_W +: SID_W], m_awaddr[s*ADDR_W +: ADDR_W], m_awlen[s*8 +: 8],
+                m_awsize[s*3 +: 3], m_awburst[s*2 +: 2], m_awlock[s], m_awcache[s*4 +: 4],
+                m_awprot[s*3 +: 3], m_awqos[s*4 +: 4]} = t_aw[s];
+        assign m_awvalid[s] = t_awvalid[s];
+        assign t_awready[s] = m_awready[s];
+
+        assign m_wdata[s*DATA_W +: DATA_W] = t_wdata[s];
+        assign m_wstrb[s*STRB_W +: STRB_W] = t_wstrb[s];
+        assign m_wlast[s]   = t_wlast[s];
+        assign m_wvalid[s]  = t_wvalid[s];
+        assign t_wready[s]  = m_wready[s];
+
+        assign t_bid[s]     = m_bid[s*SID_W +: SID_W];
+        assign t_bresp[s]   = m_bresp[s*2 +: 2];
+        assign t_bvalid[s]  = m_bvalid[s];
+        assign m_bready[s]  = t_bready[s];
+
+        assign {m_arid[s*SID_W +: SID_W], m_araddr[s*ADDR_W +: ADDR_W], m_arlen[s*8 +: 8],
+                m_arsize[s*3 +: 3], m_arburst[s*2 +: 2], m_arlock[s], m_arcache[s*4 +: 4],
+                m_arprot[s*3 +: 3], m_arqos[s*4 +: 4]} = t_ar[s];
+        assign m_arvalid[s] = t_arvalid[s];
+        assign t_arready[s] = m_arready[s];
+
+        assign t_rid[s]     = m_rid[s*SID_W +: SID_W];
+        assign t_rdata[s]   = m_rdata[s*DATA_W +: DATA_W];
+        assign t_rresp[s]   = m_rresp[s*2 +: 2];
+        assign t_rlast[s]   = m_rlast[s];
+        assign t_rvalid[s]  = m_rvalid[s];
+        assign m_rready[s]  = t_rready[s];
+    end
+
+    flowforge_axi_err_slave #(
+        .ID_W(SID_W),
+        .DATA_W(DATA_W)
+    ) u_decerr (
+        .aclk(aclk),
+        .aresetn(aresetn),
+        .awid(t_aw[NS][AP_W-1 -: SID_W]),
+        .awvalid(t_awvalid[NS]),
+        .awready(t_awready[NS]),
+        .wlast(t_wlast[NS]),
+        .wvalid(t_wvalid[NS]),
+        .wready(t_wready[NS]),
+        .bid(t_bid[NS]),
+        .bresp(t_bresp[NS]),
+        .bvalid(t_bvalid[NS]),
+        .bready(t_bready[NS]),
+        .arid(t_ar[NS][AP_W-1 -: SID_W]),
+        .arlen(t_ar[NS][24:17]),
+        .arvalid(t_arvalid[NS]),
+        .arready(t_arready[NS]),
+        .rid(t_rid[NS]),
+        .rdata(t_rdata[NS]),
+        .rresp(t_rresp[NS]),
+        .rlast(t_rlast[NS]),
+        .rvalid(t_rvalid[NS]),
+        .rready(t_rready[NS])
+    );
+
+endmodule
+)SV";
+
+const char* axi_interconnect_modules_sv() {
+    return kAxiInterconnectModules;
+}
+
+// One port of the crossbar as seen from the interconnect description.
+struct XbarEndpoint {
+    const EndpointRef* ref;
+    const InterfacePort* port;
+    const std::unordered_map<std::string, int>* params;  // nullptr for top-level ports
+    bool is_master;
+    size_t index;
+};
+
+static int clog2(size_t n) {
+    int bits = 0;
+    while ((size_t{1} << bits) < n) {
+        ++bits;
+    }
+    return bits;
+}
+
+static std::string tie_sv(int width, long long value) {
+    if (value < 0) {
+        return "{" + std::to_string(width) + "{1'b1}}";
+    }
+    return std::to_string(width) + "'d" + std::to_string(value);
+}
+
+static std::string hex_sv(int width, uint64_t value) {
+    std::ostringstream ss;
+    ss << width << "'h" << std::hex << value;
+    return ss.str();
+}
+
+std::string emit_axi_interconnect_sv(
+    const SystemIR& sys,
+    const Interconnect& ic,
+    std::vector<std::pair<std::string, int>>& interconnect_signals,
+    std::unordered_map<std::string, std::unordered_map<std::string, std::string>>& comp2sigmap
+) {
+    // the crossbar always exposes the full AXI4 signal set; AXI4-Lite
+    // endpoints leave the extra signals tied off or unconnected
+    const ProtocolDescriptor& xbar = lookup_protocol("axi4");
+    const ProtocolDescriptor& proto = lookup_protocol(ic.protocol);
+
+    std::vector<XbarEndpoint> endpoints;
+    for (size_t i = 0; i < ic.masters.size(); ++i) {
+        const EndpointRef& ep = ic.masters[i];
+        endpoints.push_back({&ep, static_cast<const InterfacePort*>(ep.port_ptr),
+                             ep.instance == "this" ? nullptr : &sys.components.at(ep.instance).parameters,
+                             true, i});
+    }
+    for (size_t i = 0; i < ic.slaves.size(); ++i) {
+        const EndpointRef& ep = ic.slaves[i].port;
+        endpoints.push_back({&ep, static_cast<const InterfacePort*>(ep.port_ptr),
+                             ep.instance == "this" ? nullptr : &sys.components.at(ep.instance).parameters,
+                             false, i});
+    }
+
+    auto where = [&](const XbarEndpoint& e) {
+        return "Interconnect " + ic.name + ": " + e.ref->instance + "." + e.ref->port;
+    };
+    auto mapped_width = [&](const XbarEndpoint& e, const std::string& sig) -> int {
+        const ProtocolSignal* ps = proto.find(sig);
+        if (!ps || !e.port->port_maps.count(sig)) {
+            return -1;
+        }
+        return signal_width(*e.port, *ps, e.params);
+    };
+
+    for (const auto& e : endpoints) {
+        check_required_signals(*e.port, proto, e.ref->instance == "this" ? "" : e.ref->instance);
+    }
+
+    // no width conversion: every endpoint must agree on address and data
+    // width, and masters that carry IDs on the ID width
+    int addr_w = -1, data_w = -1, id_w = -1;
+    for (const auto& e : endpoints) {
+        const int a = mapped_width(e, "awaddr");
+        const int d = mapped_width(e, "wdata");
+        if (addr_w < 0) addr_w = a;
+        if (data_w < 0) data_w = d;
+        if (a != addr_w || d != data_w) {
+            throw std::runtime_error(where(e) + " has address/data width " + std::to_string(a) + "/" + std::to_string(d)
+                                     + ", expected " + std::to_string(addr_w) + "/" + std::to_string(data_w));
+        }
+        const int id = mapped_width(e, "awid");
+        if (e.is_master && id > 0) {
+            if (id_w > 0 && id != id_w) {
+                throw std::runtime_error(where(e) + " has ID width " + std::to_string(id) + ", expected " + std::to_string(id_w));
+            }
+            id_w = id;
+        }
+    }
+    if (id_w <= 0) {
+        id_w = 1;
+    }
+    const int mi_w = std::max(1, clog2(ic.masters.size()));
+    const int sid_w = id_w + mi_w;
+
+    // slave IDs carry the master index on top of the master's ID
+    for (const auto& e : endpoints) {
+        const int id = mapped_width(e, "awid");
+        if (!e.is_master && id > 0 && id != sid_w) {
+            throw std::runtime_error(where(e) + " needs ID width " + std::to_string(sid_w)
+                                     + " (master ID width " + std::to_string(id_w) + " + "
+                                     + std::to_string(mi_w) + " bits of master index)");
+        }
+    }
+
+    // slaves without IDs answer in order and get routed by the crossbar's
+    // order FIFOs; an AXI4 slave must map either all ID signals or none
+    std::string no_id;
+    for (auto e = endpoints.rbegin(); e != endpoints.rend(); ++e) {
+        if (e->is_master) {
+            continue;
+        }
+        int ids = 0;
+        for (const char* sig : {"awid", "bid", "arid", "rid"}) {
+            ids += mapped_width(*e, sig) > 0;
+        }
+        if (ids != 0 && ids != 4) {
+            throw std::runtime_error(where(*e) + " must map all of awid/bid/arid/rid or none of them");
+        }
+        no_id += ids ? '0' : '1';
+    }
+
+    auto xbar_width = [&](const ProtocolSignal& sig, bool master_side) {
+        if (sig.width_param == "addr_width") return addr_w;
+        if (sig.width_param == "data_width") return data_w / static_cast<int>(sig.width_div);
+        if (sig.width_param == "id_width")   return master_side ? id_w : sid_w;
+        return static_cast<int>(sig.width);
+    };
+
+    // bind every crossbar signal of every endpoint; parts[i] is endpoint i
+    std::unordered_map<std::string, std::vector<std::string>> buses;
+    size_t unused = 0;
+    for (const auto& e : endpoints) {
+        const std::string side = e.is_master ? "s_" : "m_";
+        const size_t count = e.is_master ? ic.masters.size() : ic.slaves.size();
+        const bool top = (e.ref->instance == "this");
+
+        for (const auto& sig : xbar.signals) {
+            auto& parts = buses[side + sig.name];
+            parts.resize(count);
+
+            const int width = xbar_width(sig, e.is_master);
+            const bool into_xbar = (sig.from_master == e.is_master);
+            const ProtocolSignal* ps = proto.find(sig.name);
+            auto mit = e.port->port_maps.find(sig.name);
+
+            if (ps && mit != e.port->port_maps.end()) {
+                if (signal_width(*e.port, *ps, e.params) != width) {
+                    throw std::runtime_error(where(e) + " signal " + sig.name + " is not " + std::to_string(width) + " bits wide");
+                }
+                if (top) {
+                    parts[e.index] = mit->second;
+                } else {
+                    std::string net = ic.name + "_" + (e.is_master ? "m" : "s") + std::to_string(e.index) + "_" + sig.name;
+                    interconnect_signals.emplace_back(net, width);
+                    comp2sigmap[e.ref->instance][mit->second] = net;
+                    parts[e.index] = net;
+                }
+            } else if (into_xbar) {
+                parts[e.index] = tie_sv(width, sig.tie);
+            } else {
+                std::string net = ic.name + "_unused_" + std::to_string(unused++);
+                interconnect_signals.emplace_back(net, width);
+                parts[e.index] = net;
+            }
+        }
+    }
+
+    // clock and reset follow the first component endpoint
+    const XbarEndpoint* clocked = nullptr;
+    for (const auto& e : endpoints) {
+        if (e.ref->instance != "this") {
+            clocked = &e;
+            break;
+        }
+    }
+    if (!clocked) {
+        throw std::runtime_error("Interconnect " + ic.name + " needs at least one component endpoint to take its clock from");
+    }
+    const auto& clk_map = comp2sigmap[clocked->ref->instance];
+    auto clk = clk_map.find("aclk");
+    auto rst = clk_map.find("aresetn");
+    if (clk == clk_map.end() || rst == clk_map.end()) {
+        throw std::runtime_error("Interconnect " + ic.name + " needs aclk/aresetn bound on instance " + clocked->ref->instance);
+    }
+
+    std::string bases, masks;
+    const uint64_t addr_mask = addr_w >= 64 ? ~uint64_t{0} : ((uint64_t{1} << addr_w) - 1);
+    for (size_t i = ic.slaves.size(); i-- > 0;) {
+        const AddressWindow& w = ic.slaves[i];
+        if (((w.base + w.size - 1) & ~addr_mask) != 0) {
+            throw std::runtime_error("Interconnect " + ic.name + ": window of " + w.port.instance + "." + w.port.port
+                                     + " does not fit in " + std::to_string(addr_w) + " address bits");
+        }
+        bases += hex_sv(addr_w, w.base) + (i ? ", " : "");
+        masks += hex_sv(addr_w, ~(w.size - 1) & addr_mask) + (i ? ", " : "");
+    }
+
+    std::ostringstream ss;
+    ss << "\nflowforge_axi_xbar#(\n"
+       << "        .NM(" << ic.masters.size() << "),\n"
+       << "        .NS(" << ic.slaves.size() << "),\n"
+       << "        .ADDR_W(" << addr_w << "),\n"
+       << "        .DATA_W(" << data_w << "),\n"
+       << "        .ID_W(" << id_w << "),\n"
+       << "        .MAX_OUTSTANDING(" << ic.max_outstanding << "),\n"
+       << "        .SLAVE_NO_ID(" << ic.slaves.size() << "'b" << no_id << "),\n"
+       << "        .SLAVE_BASE({" << bases << "}),\n"
+       << "        .SLAVE_MASK({" << masks << "})\n"
+       << "    ) " << ic.name << " (\n"
+       << "        .aclk(" << clk->second << "),\n"
+       << "        .aresetn(" << rst->second << ")";
+
+    for (const std::string side : {"s_", "m_"}) {
+        for (const auto& sig : xbar.signals) {
+            const auto& parts = buses.at(side + sig.name);
+            ss << ",\n        ." << side << sig.name << "(";
+            if (parts.size() == 1) {
+                ss << parts[0];
+            } else {
+                ss << "{";
+                for (size_t i = parts.size(); i-- > 0;) {
+                    ss << parts[i] << (i ? ", " : "");
+                }
+                ss << "}";
+            }
+            ss << ")";
+        }
+    }
+    ss << "\n    );\n";
+
+    return ss.str();
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "../base/system_ir.hpp"
+
+// Bind the endpoints of a memory-mapped interconnect and return the
+// flowforge_axi_xbar instance for it.  Signals between the crossbar and
+// component ports are appended to interconnect_signals and the component
+// side of each binding is recorded in comp2sigmap, which must already hold
+// the aclk/aresetn bindings of the endpoint components.
+std::string emit_axi_interconnect_sv(
+    const SystemIR& sys,
+    const Interconnect& ic,
+    std::vector<std::pair<std::string, int>>& interconnect_signals,
+    std::unordered_map<std::string, std::unordered_map<std::string, std::string>>& comp2sigmap
+);
+
+// Definitions of the modules instantiated by emit_axi_interconnect_sv.
+const char* axi_interconnect_modules_sv();
@@ -1,43 +1,39 @@
 #include "sv_emitter.hpp"
 #include "../base/port.hpp"
+#include "../base/protocol.hpp"
+#include "axi_interconnect.hpp"
 
 #include <iostream>
 #include <sstream>
 #include <fstream>
 
-std::string normalize(std::string s) {
-    s.erase(0, s.find_first_not_of(" \t\n\r"));
-    s.erase(s.find_last_not_of(" \t\n\r") + 1);
-    return s;
-}
-
 static std::string emit_wire_port(const WirePort& p) {
     std::ostringstream ss;
     ss << "    " << to_string(p.mode) << " logic " << p.name;
     return ss.str();
 }
 
-static std::string emit_axi_stream_port(const InterfacePort& p) {
+static std::string emit_interface_port(const InterfacePort& p) {
     std::ostringstream ss;
+    const ProtocolDescriptor& proto = lookup_protocol(p.protocol);
     const bool is_slave = (p.mode == PortMode::Slave);
-
-    auto dir = [&](const std::string& sig) {
-        if (sig == "tready")
-            return is_slave ? "output" : "input";
-        return is_slave ? "input" : "output";
-    };
+    check_required_signals(p, proto);
 
     bool first = true;
-    for (const auto& [axi_sig, sv_name] : p.port_maps) {
+    for (const auto& [sig_name, sv_name] : p.port_maps) {
+        const ProtocolSignal* sig = proto.find(sig_name);
+        if (!sig) {
+            throw std::runtime_error("Unknown " + p.protocol + " signal '" + sig_name + "' in port " + p.name);
+        }
         if (!first) ss << ",\n";
         first = false;
 
-        ss << "    " << dir(axi_sig) << " logic";
+        const bool is_input = (sig->from_master == is_slave);
+        ss << "    " << (is_input ? "input" : "output") << " logic";
 
-        if (axi_sig == "tdata") {
-            ss << " [" << p.parameters.at("tdata_width") << "-1:0]";
-        } else if (axi_sig == "tdest") {
-            ss << " [" << p.parameters.at("tdest_width") << "-1:0]";
+        const std::string range = signal_range_sv(p, *sig);
+        if (!range.empty()) {
+            ss << " " << range;
         }
 
         ss << " " << sv_name;
@@ -46,35 +42,38 @@ static std::string emit_axi_stream_port(const InterfacePort& p) {
     return ss.str();
 }
 
+std::string find_module_name(const std::string& src_path) {
+    std::ifstream in(src_path);
+    if (!in) {
+        throw std::runtime_error("Unable to open component source " + src_path);
+    }
+    std::string module_name;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream iss(line);
+        std::string token;
+        if (!(iss >> token)) { continue; }
+        if (token == "module") {
+            if (!(iss >> module_name)) {
+                throw std::runtime_error("Malformed module declaration in " + src_path);
+            }
+            break;
+        }
+    }
+    if (module_name.empty()) {
+        throw std::runtime_error("No module declaration found in " + src_path);
+    }
+    return module_name;
+}
+
 std::string emit_module_instance_sv(
     const Component& comp,    
     const std::unordered_map<std::string, std::string> signal_map
 ) {
     std::ostringstream ss;
 
-    //find the module name from verilog source path
-    std::string module_name;
-    {
-        std::ifstream in(comp.src_path);
-        if (!in) {
-            throw std::runtime_error("Unable to open component source " + comp.src_path);
-        }
-        std::string line;
-        while (std::getline(in, line)) {
-            std::istringstream iss(line);
-            std::string token;
-            if (!(iss >> token)) { continue; }
-            if (token == "module") {
-                if (!(iss >> module_name)) {
-                    throw std::runtime_error("Malformed module declaration in " + comp.src_path);
-                }
-                break;
-            }
-        }
-        if (module_name.empty()) {
-            throw std::runtime_error("No module declaration found in " + comp.src_path);
-        }
-    }
+    const std::string module_name =
+        comp.module_name.empty() ? find_module_name(comp.src_path) : comp.module_name;
 
     if(signal_map.size() != 0){
         ss << "\n" << module_name;
@@ -123,6 +122,7 @@ void populate_conn_map(
         if (comp_ip.protocol != ext_ip.protocol) {
             throw std::runtime_error("Interface protocol mismatch in connection for instance " + comp_instance);
         }
+        check_required_signals(comp_ip, lookup_protocol(comp_ip.protocol), comp_instance);
 
         for (const auto& [port_name, signal_name] : comp_ip.port_maps) {
             auto ext_name = ext_ip.port_maps.find(port_name);
@@ -140,7 +140,7 @@ void populate_conn_map(
     }
 }
 
-Port* create_intermediate_port(const Port* src_port, const Port* dst_port, std::vector<std::pair<std::string, int>>* interconnect_signals, const std::unordered_map<std::string, int>* comp_parameters = nullptr) {
+std::unique_ptr<Port> create_intermediate_port(const Port* src_port, const Port* dst_port, std::vector<std::pair<std::string, int>>* interconnect_signals, const std::unordered_map<std::string, int>* comp_parameters = nullptr) {
     if (src_port->type != dst_port->type) {
         throw std::runtime_error("Port type mismatch in intermediate connection");
     }
@@ -151,7 +151,7 @@ Port* create_intermediate_port(const Port* src_port, const Port* dst_port, std::
         const auto* wp = static_cast<const WirePort*>(src_port);
         width = wp->width;
         interconnect_signals->emplace_back(signal_name, width);
-        WirePort* new_port = (WirePort*)malloc(sizeof(WirePort));
+        auto new_port = std::make_unique<WirePort>();
         new_port->name = signal_name;
         new_port->mode = wp->mode;
         new_port->width = width;
@@ -160,74 +160,194 @@ Port* create_intermediate_port(const Port* src_port, const Port* dst_port, std::
         
     } else if (src_port->type == PortType::Interface) {
         const auto* ip = static_cast<const InterfacePort*>(src_port);
-        if (ip->protocol == "axi_stream") {
-            //iterate through the port maps and create intermediate signals for each
-            std::string base_signal_name = "interconnect_" + std::to_string(interconnect_signals->size());
-            for (const auto& [port_name, signal_name] : ip->port_maps) {
-                std::cout << "Processing port map: " << port_name << " -> " << signal_name << std::endl;
-                std::string interconnect_signal_name = base_signal_name + "_" + port_name;
-                int width = 1;
-                std::string width_str;
-                if (port_name == "tdata") {
-                    //the tdata width itself might be a parameter, so we find out what parameter it is and look it up in the component parameters if it exists
-                    if (ip->parameters.find("tdata_width") != ip->parameters.end()) {
-                        width_str = normalize(ip->parameters.at("tdata_width"));
-                    } else {
-                        throw std::runtime_error("tdata_width parameter not found in interface port");
-                    }
-                    std::cout << "comp_parameters: " << std::endl;
-                    for (const auto& [k, v] : *comp_parameters) {
-                        std::cout << "  " << k << " = " << v << " key length: "<< k.length() << std::endl;
-                    }
-                    std::cout << "width_str: " << "[" << width_str << "]" << "width_str length: " << width_str.length() << std::endl;
-                    auto it = comp_parameters->find(width_str);
-                    if(it != comp_parameters->end()) {
-                        width = it->second;
-                    } else {
-                        width = std::stoi(width_str);
-                    }
-                    std::cout << "Determined width for tdata: " << width << std::endl;
-                    
-                } else if (port_name == "tdest") {
-                    //the tdest width itself might be a parameter, so we find out what parameter it is and look it up in the component parameters if it exists                           
-                    std::string width_str;
-                    if (ip->parameters.find("tdest_width") != ip->parameters.end()) {
-                        width_str = normalize(ip->parameters.at("tdest_width"));
-                    } else {
-                        throw std::runtime_error("tdest_width parameter not found in interface port");
-                    }
-                    auto it = comp_parameters->find(width_str);
-                    if(it != comp_parameters->end()) {
-                        width = it->second;
-                    } else {
-                        width = std::stoi(width_str);
-                    }
-                    std::cout << "Determined width for tdest: " << width << std::endl;
-                }
-                interconnect_signals->emplace_back(interconnect_signal_name, width);
-            }            
-            InterfacePort* new_port = new InterfacePort();
-            new_port->name = base_signal_name;
-            new_port->mode = ip->mode;
-            new_port->protocol = ip->protocol;
-            new_port->parameters = ip->parameters;            
-            //give new names to the port maps based on the interconnect signal names
-            for (const auto& [port_name, signal_name] : ip->port_maps) {
-                std::string interconnect_signal_name = base_signal_name + "_" + port_name;
-                std::cout << "Mapping port " << port_name << " to intermediate signal " << interconnect_signal_name << std::endl;
-                new_port->port_maps[port_name] = interconnect_signal_name;
+        const ProtocolDescriptor& proto = lookup_protocol(ip->protocol);
+
+        //iterate through the port maps and create intermediate signals for each
+        std::string base_signal_name = "interconnect_" + std::to_string(interconnect_signals->size());
+        for (const auto& [port_name, signal_name] : ip->port_maps) {
+            const ProtocolSignal* sig = proto.find(port_name);
+            if (!sig) {
+                throw std::runtime_error("Unknown " + ip->protocol + " signal '" + port_name + "' in port " + ip->name);
             }
-            std::cout << "Created intermediate interface port: " << new_port->name << " with protocol " << new_port->protocol << std::endl;
-            return new_port;
-        } else {
-            throw std::runtime_error("Unsupported interface protocol in intermediate connection");
+            //the width itself might be a parameter of the source component
+            int width = signal_width(*ip, *sig, comp_parameters);
+            interconnect_signals->emplace_back(base_signal_name + "_" + port_name, width);
+        }
+        auto new_port = std::make_unique<InterfacePort>();
+        new_port->name = base_signal_name;
+        new_port->mode = ip->mode;
+        new_port->protocol = ip->protocol;
+        new_port->parameters = ip->parameters;
+        //give new names to the port maps based on the interconnect signal names
+        for (const auto& [port_name, signal_name] : ip->port_maps) {
+            new_port->port_maps[port_name] = base_signal_name + "_" + port_name;
         }
+        return new_port;
     } else {
         throw std::runtime_error("Unknown port type in intermediate connection");
-        return nullptr;
     }
-    
-    
+}
+
+// A buffered connection between two component ports, emitted as an instance
+// of flowforge_axis_link.
+struct LinkInstance {
+    std::string name;
+    std::string src_instance;
+    const LinkConfig* config;
+    const InterfacePort* upstream;    // signals driven by the source component
+    const InterfacePort* downstream;  // signals driven by the link
+    const std::unordered_map<std::string, int>* src_parameters;
+};
+
+static const char kAxisLinkModule[] = R"SV(module flowforge_axis_link #(
+    parameter DATA_WIDTH  = 32,
+    parameter DEST_WIDTH  = 1,
+    parameter FIFO_DEPTH  = 0,
+    parameter PIPE_STAGES = 0
+)(
+    input  logic                  aclk,
+    input  logic                  aresetn,
+
+    input  logic [DATA_WIDTH-1:0] s_axis_tdata,
+    input  logic                  s_axis_tvalid,
+    output logic                  s_axis_tready,
+    input  logic                  s_axis_tlast,
+    input  logic [DEST_WIDTH-1:0] s_axis_tdest,
+
+    output logic [DATA_WIDTH-1:0] m_axis_tdata,
+    output logic                  m_axis_tvalid,
+    input  logic                  m_axis_tready,
+    output logic                  m_axis_tlast,
+    output logic [DEST_WIDTH-1:0] m_axis_tdest
+);
+    localparam W = DATA_WIDTH + DEST_WIDTH + 1;
+
+    // stage 0 is the slave side, stage 1 the FIFO output, stages 2.. the
+    // register slices, and the last stage drives the master side
+    logic [W-1:0] stage_data  [0:PIPE_STAGES+1];
+    logic         stage_valid [0:PIPE_STAGES+1];
+    logic         stage_ready [0:PIPE_STAGES+1];
+
+    assign stage_data[0]  = {s_axis_tlast, s_axis_tdest, s_axis_tdata};
+    assign stage_valid[0] = s_axis_tvalid;
+    assign s_axis_tready  = stage_ready[0];
+
+    generate
+        if (FIFO_DEPTH > 0) begin : g_fifo
+            localparam AW = (FIFO_DEPTH > 1) ? $clog2(FIFO_DEPTH) : 1;
+
+            logic [W-1:0]  mem [0:FIFO_DEPTH-1];
+            logic [AW-1:0] wr_ptr, rd_ptr;
+            logic [AW:0]   count;
+
+            wire push = stage_valid[0] && stage_ready[0];
+            wire pop  = stage_valid[1] && stage_ready[1];
+
+            assign stage_ready[0] = (count != FIFO_DEPTH);
+            assign stage_valid[1] = (count != 0);
+            assign stage_data[1]  = mem[rd_ptr];
+
+            always_ff @(posedge aclk) begin
+                if (!aresetn) begin
+                    wr_ptr <= '0;
+                    rd_ptr <= '0;
+                    count  <= '0;
+                end else begin
+                    if (push) begin
+                        mem[wr_ptr] <= stage_data[0];
+                        wr_ptr <= (wr_ptr == FIFO_DEPTH-1) ? '0 : wr_ptr + 1'b1;
+                    end
+                    if (pop) begin
+                        rd_ptr <= (rd_ptr == FIFO_DEPTH-1) ? '0 : rd_ptr + 1'b1;
+                    end
+                    count <= count + push - pop;
+                end
+            end
+        end else begin : g_no_fifo
+            assign stage_data[1]  = stage_data[0];
+            assign stage_valid[1] = stage_valid[0];
+            assign stage_ready[0] = stage_ready[1];
+        end
+
+        for (genvar i = 1; i <= PIPE_STAGES; i++) begin : g_pipe
+            logic [W-1:0] data_q;
+            logic         valid_q;
+
+            assign stage_ready[i]   = !valid_q || stage_ready[i+1];
+            assign stage_valid[i+1] = valid_q;
+            assign stage_data[i+1]  = data_q;
+
+            always_ff @(posedge aclk) begin
+                if (!aresetn) begin
+                    valid_q <= 1'b0;
+                end else if (stage_ready[i]) begin
+                    valid_q <= stage_valid[i];
+                    data_q  <= stage_data[i];
+                end
+            end
+        end
+    endgenerate
+
+    assign {m_axis_tlast, m_axis_tdest, m_axis_tdata} = stage_data[PIPE_STAGES+1];
+    assign m_axis_tvalid = stage_valid[PIPE_STAGES+1];
+    assign stage_ready[PIPE_STAGES+1] = m_axis_tready;
+
+endmodule
+)SV";
+
+static std::string emit_link_instance_sv(
+    const LinkInstance& link,
+    const std::unordered_map<std::string, std::string>& src_sigmap
+) {
+    if (link.upstream->protocol != "axi_stream") {
+        throw std::runtime_error("Link buffering is only supported for axi_stream connections: " + link.name);
+    }
+
+    auto clk = src_sigmap.find("aclk");
+    auto rst = src_sigmap.find("aresetn");
+    if (clk == src_sigmap.end() || rst == src_sigmap.end()) {
+        throw std::runtime_error("Link " + link.name + " needs aclk/aresetn bound on instance " + link.src_instance);
+    }
+
+    const auto& up = link.upstream->port_maps;
+    const auto& down = link.downstream->port_maps;
+    const bool has_tdest = up.count("tdest") != 0;
+
+    std::ostringstream ss;
+    ss << "\nflowforge_axis_link#(\n"
+       << "        .DATA_WIDTH(" << resolve_interface_width(*link.upstream, "tdata_width", link.src_parameters) << "),\n"
+       << "        .DEST_WIDTH(" << (has_tdest ? resolve_interface_width(*link.upstream, "tdest_width", link.src_parameters) : 1) << "),\n"
+       << "        .FIFO_DEPTH(" << link.config->fifo_depth << "),\n"
+       << "        .PIPE_STAGES(" << link.config->pipeline_stages << ")\n"
+       << "    ) " << link.name << " (\n"
+       << "        .aclk(" << clk->second << "),\n"
+       << "        .aresetn(" << rst->second << ")";
+
+    // absent sideband signals: tlast defaults high, tdest to zero
+    auto bind_slave = [&](const std::string& sig, const std::string& tie) {
+        auto it = up.find(sig);
+        ss << ",\n        .s_axis_" << sig << "(" << (it != up.end() ? it->second : tie) << ")";
+    };
+    auto bind_master = [&](const std::string& sig) {
+        auto it = down.find(sig);
+        if (it != down.end()) {
+            ss << ",\n        .m_axis_" << sig << "(" << it->second << ")";
+        }
+    };
+
+    bind_slave("tdata", "'0");
+    bind_slave("tvalid", "1'b0");
+    bind_slave("tready", "");
+    bind_slave("tlast", "1'b1");
+    bind_slave("tdest", "'0");
+    bind_master("tdata");
+    bind_master("tvalid");
+    bind_master("tready");
+    bind_master("tlast");
+    bind_master("tdest");
+    ss << "\n    );\n";
+
+    return ss.str();
 }
 
 std::string emit_top_module_sv(
@@ -235,7 +355,15 @@ std::string emit_top_module_sv(
     const std::string& module_name
 ) {
     std::ostringstream ss;
+    emit_top_module_sv(sys, module_name, ss);
+    return ss.str();
+}
 
+void emit_top_module_sv(
+    const SystemIR& sys,
+    const std::string& module_name,
+    std::ostream& ss
+) {
     ss << "module " << module_name << " (\n";
 
     bool first = true;
@@ -250,7 +378,7 @@ std::string emit_top_module_sv(
             ss << emit_wire_port(*wp);       // safe: wp is really a WirePort
         } 
         else if (auto ip = dynamic_cast<const InterfacePort*>(p)) {
-            ss << emit_axi_stream_port(*ip); // safe: ip is really an InterfacePort
+            ss << emit_interface_port(*ip);  // safe: ip is really an InterfacePort
         } 
         else {
             // optional: unknown type
@@ -261,9 +389,14 @@ std::string emit_top_module_sv(
 
     std::unordered_map<std::string, std::unordered_map<std::string, std::string>> comp2sigmap;
     std::vector<std::pair<std::string, int>> interconnect_signals; // (signal_name, width)
+    std::vector<std::unique_ptr<Port>> intermediate_ports; // owned for the duration of emission
+    std::vector<LinkInstance> links;
 
     // Populate signal maps for each component instance
     for (const auto& conn : sys.connections) {
+        if (conn.link.buffered()) {
+            check_linkable(conn);
+        }
         // src and dst are already resolved to actual Port* in parse_connections
         const Port* src_port = conn.src.port_ptr;
         for (const auto& dst : conn.dsts) {
@@ -278,14 +411,38 @@ std::string emit_top_module_sv(
             } else if (dst.instance == "this") {
                 // dst is top-level, src is component port
                 populate_conn_map(conn.src.instance, conn.src.port_ptr, dst.port_ptr, comp2sigmap);
+            } else if (conn.link.buffered()) {
+                // src -> upstream signals -> link -> downstream signals -> dst
+                const auto* src_params = &(sys.components.at(conn.src.instance).parameters);
+                intermediate_ports.push_back(create_intermediate_port(src_port, dst_port, &interconnect_signals, src_params));
+                const Port* upstream = intermediate_ports.back().get();
+                intermediate_ports.push_back(create_intermediate_port(src_port, dst_port, &interconnect_signals, src_params));
+                const Port* downstream = intermediate_ports.back().get();
+                populate_conn_map(conn.src.instance, conn.src.port_ptr, upstream, comp2sigmap);
+                populate_conn_map(dst.instance, dst.port_ptr, downstream, comp2sigmap);
+                links.push_back({
+                    conn.name + "_link_" + std::to_string(links.size()),
+                    conn.src.instance,
+                    &conn.link,
+                    static_cast<const InterfacePort*>(upstream),
+                    static_cast<const InterfacePort*>(downstream),
+                    src_params
+                });
             } else {
-                Port* intermediate_port = create_intermediate_port(src_port, dst_port, &interconnect_signals, &(sys.components.at(conn.src.instance).parameters));
+                intermediate_ports.push_back(create_intermediate_port(src_port, dst_port, &interconnect_signals, &(sys.components.at(conn.src.instance).parameters)));
+                const Port* intermediate_port = intermediate_ports.back().get();
                 populate_conn_map(conn.src.instance, conn.src.port_ptr, intermediate_port, comp2sigmap);
                 populate_conn_map(dst.instance, dst.port_ptr, intermediate_port, comp2sigmap);                
             }
         }
     }
     
+    // Bind memory-mapped interconnects; their instances follow the components
+    std::vector<std::string> interconnect_instances;
+    for (const auto& ic : sys.interconnects) {
+        interconnect_instances.push_back(emit_axi_interconnect_sv(sys, ic, interconnect_signals, comp2sigmap));
+    }
+
     // Emit intermediate signals for connections between component ports
     
     for (const auto& [signal_name, width] : interconnect_signals) {        
@@ -302,7 +459,21 @@ std::string emit_top_module_sv(
         ss << emit_module_instance_sv(comp, sig_map);
     }
 
+    // Emit buffered links; they share the clock/reset of their source component
+    for (const auto& link : links) {
+        ss << emit_link_instance_sv(link, comp2sigmap[link.src_instance]);
+    }
+
+    for (const auto& inst : interconnect_instances) {
+        ss << inst;
+    }
+
     ss << "\nendmodule\n";
 
-    return ss.str();
+    if (!links.empty()) {
+        ss << "\n" << kAxisLinkModule;
+    }
+    if (!sys.interconnects.empty()) {
+        ss << "\n" << axi_interconnect_modules_sv();
+    }
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <ostream>
 #include <string>
 #include "../base/system_ir.hpp"
 
@@ -12,3 +13,15 @@ std::string emit_top_module_sv(
     const SystemIR& sys,
     const std::string& module_name
 );
+
+
+// Same as above, but writes into a caller-provided stream so repeated
+// emission can reuse the caller's buffer.
+void emit_top_module_sv(
+    const SystemIR& sys,
+    const std::string& module_name,
+    std::ostream& out
+);
+
+// Return the name of the first module declared in a SystemVerilog source.
+std::string find_module_name(const std::string& src_path);